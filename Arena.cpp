@@ -0,0 +1,67 @@
+/**
+ * @file Arena.cpp
+ * @brief Implementation file for the Arena class
+ * @authors Jacob Franco, Zach Gassner, Haley Joerger, Adam Lyday
+ */
+
+#include "Arena.hpp"
+#include <algorithm>
+
+/**
+ * @brief Constructor
+ * @remark No block is allocated until the first object is made
+ */
+Arena::Arena() : current(0), next(nullptr), end(nullptr) { }
+
+/**
+ * @brief Destructor
+ * @remark Frees every block, without looking at what is in them
+ */
+Arena::~Arena() {
+    for (const Block& block : blocks)
+        operator delete(block.memory, align_val_t(CACHE_LINE_SIZE));
+}
+
+/**
+ * @brief Forgets every object, keeping the blocks to be used again
+ */
+void Arena::reset() {
+    current = 0;
+    next = blocks.empty() ? nullptr : blocks[0].memory;
+    end = blocks.empty() ? nullptr : blocks[0].memory + blocks[0].size;
+}
+
+/**
+ * @brief Moves on to the next block that has room, allocating it if there
+ *        is none
+ * @param size - The number of bytes needed
+ * @param alignment - A power of two the address must be a multiple of
+ * @remark Blocks start on a cache line, so an object that needs no more 
+ *         alignment than that fits at the start of any block big enough. 
+ *         One that needs more starts far enough into the block to be 
+ *         aligned.
+ */
+void* Arena::allocateInNextBlock(size_t size, size_t alignment) {
+    size_t padding = alignment > CACHE_LINE_SIZE ? 
+                     alignment - CACHE_LINE_SIZE : 0;
+
+    // after a reset the blocks from before are used again, in order
+    if (next != nullptr)
+        current++;
+
+    while (current < blocks.size() && blocks[current].size < size + padding)
+        current++;
+
+    if (current == blocks.size()) {
+        size_t blockSize = max(size + padding, ARENA_BLOCK_SIZE);
+        char* memory = static_cast<char*>(
+            operator new(blockSize, align_val_t(CACHE_LINE_SIZE)));
+        blocks.push_back(Block{memory, blockSize});
+    }
+
+    char* memory = blocks[current].memory;
+    memory += -reinterpret_cast<size_t>(memory) & (alignment - 1);
+    next = memory + size;
+    end = blocks[current].memory + blocks[current].size;
+    return memory;
+}
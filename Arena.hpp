@@ -0,0 +1,131 @@
+/**
+ * @file Arena.hpp
+ * @brief Defines the Arena class, a bump allocator that frees everything it
+ *        handed out at once
+ * @authors Jacob Franco, Zach Gassner, Haley Joerger, Adam Lyday
+ */
+
+#ifndef ARENA_HPP
+#define ARENA_HPP
+
+#include <cstddef>
+#include <new>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+using namespace std;
+
+/**
+ * @brief The number of bytes the arena asks for at a time
+ */
+const size_t ARENA_BLOCK_SIZE = 1 << 16;
+
+/**
+ * @brief Every block starts on a cache line
+ */
+const size_t CACHE_LINE_SIZE = 64;
+
+/**
+ * @class Arena
+ * @brief Hands out memory from large blocks by moving a pointer forward
+ * @remark Nothing is freed on its own; the blocks are all freed when the 
+ *         arena dies, or rewound by reset() to be used again. Objects made
+ *         one after another sit next to each other in memory. Only objects
+ *         that need no destructor can be made in an arena.
+ */
+class Arena {
+public:
+    /**
+     * @brief Constructor
+     * @remark No block is allocated until the first object is made
+     */
+    Arena();
+
+    /**
+     * @brief Destructor
+     * @remark Frees every block, without looking at what is in them
+     */
+    ~Arena();
+
+    /**
+     * @brief The arena owns its blocks, so it cannot be copied
+     */
+    Arena(const Arena&) = delete;
+    Arena& operator = (const Arena&) = delete;
+
+    /**
+     * @brief Returns memory for an object
+     * @param size - The number of bytes needed
+     * @param alignment - A power of two the address must be a multiple of,
+     *                    at most CACHE_LINE_SIZE
+     */
+    void* allocate(size_t size, size_t alignment) {
+        size_t skip = -reinterpret_cast<size_t>(next) & (alignment - 1);
+
+        if (size + skip > size_t(end - next))
+            return allocateInNextBlock(size, alignment);
+
+        void* memory = next + skip;
+        next += skip + size;
+        return memory;
+    }
+
+    /**
+     * @brief Makes an object in the arena
+     * @param args - The arguments for the object's constructor
+     */
+    template <typename T, typename... Args>
+    T* create(Args&&... args) {
+        static_assert(is_trivially_destructible<T>::value,
+                      "objects in an arena are never destroyed");
+        return new (allocate(sizeof(T), alignof(T))) 
+            T(forward<Args>(args)...);
+    }
+
+    /**
+     * @brief Forgets every object, keeping the blocks to be used again
+     * @remark Objects made before must not be used after this
+     */
+    void reset();
+
+private:
+    /**
+     * @brief Moves on to the next block that has room, allocating it if 
+     *        there is none
+     * @param size - The number of bytes needed
+     * @param alignment - A power of two the address must be a multiple of
+     */
+    void* allocateInNextBlock(size_t size, size_t alignment);
+
+    /**
+     * @struct Block
+     * @brief One allocation the arena hands memory out of
+     */
+    struct Block {
+        char* memory;
+        size_t size;
+    };
+
+    /**
+     * @brief Every block, in the order they are used
+     */
+    vector<Block> blocks;
+
+    /**
+     * @brief The index in blocks of the block in use
+     */
+    size_t current;
+
+    /**
+     * @brief The first free byte of the block in use
+     */
+    char* next;
+
+    /**
+     * @brief One past the last byte of the block in use
+     */
+    char* end;
+};
+
+#endif
@@ -0,0 +1,77 @@
+/**
+ * @file CharClass.hpp
+ * @brief Defines the character classes the lexers look characters up in
+ * @authors Jacob Franco, Zach Gassner, Haley Joerger, Adam Lyday
+ */
+
+#ifndef CHAR_CLASS_HPP
+#define CHAR_CLASS_HPP
+
+#include <array>
+#include <cstdint>
+
+using namespace std;
+
+/**
+ * @enum CharClass
+ * @brief The classes a character can belong to; a character can be in more
+ *        than one, so each class is a bit
+ */
+enum CharClass : uint8_t {
+    // a character that always ends an identifier or integer
+    CHAR_SYMBOL = 1 << 0,
+    CHAR_DIGIT = 1 << 1,
+    CHAR_IDENT_START = 1 << 2,
+    CHAR_IDENT_CONTINUE = 1 << 3,
+    // whitespace as isspace sees it in the "C" locale
+    CHAR_WHITESPACE = 1 << 4,
+    CHAR_NEWLINE = 1 << 5,
+};
+
+/**
+ * @brief Builds the class table at compile time
+ * @returns The classes of every byte value
+ * @remark Bytes 128 and up, which make up multi-byte UTF-8 characters, are
+ *         in no class
+ */
+constexpr array<uint8_t, 256> makeCharClasses() {
+    array<uint8_t, 256> classes = {};
+    const char symbols[] = "()[]{}\"';,=+-\\*%^><&|!";
+
+    for (const char* symbol = symbols; *symbol; symbol++)
+        classes[static_cast<unsigned char>(*symbol)] |= CHAR_SYMBOL;
+
+    for (int c = '0'; c <= '9'; c++)
+        classes[c] |= CHAR_DIGIT | CHAR_IDENT_CONTINUE;
+
+    for (int c = 'a'; c <= 'z'; c++) {
+        classes[c] |= CHAR_IDENT_START | CHAR_IDENT_CONTINUE;
+        classes[c - 'a' + 'A'] |= CHAR_IDENT_START | CHAR_IDENT_CONTINUE;
+    }
+
+    classes['_'] |= CHAR_IDENT_START | CHAR_IDENT_CONTINUE;
+
+    for (int c = '\t'; c <= '\r'; c++)
+        classes[c] |= CHAR_WHITESPACE;
+
+    classes[' '] |= CHAR_WHITESPACE;
+    classes['\n'] |= CHAR_NEWLINE;
+    return classes;
+}
+
+/**
+ * @brief The classes of every byte value, shared by every lexer
+ */
+inline constexpr array<uint8_t, 256> CHAR_CLASSES = makeCharClasses();
+
+/**
+ * @brief Returns true if c is in any of the given classes
+ * @param c - A character
+ * @param classes - One CharClass, or several joined with |
+ * @remark A single table load, and safe for bytes that are negative as a char
+ */
+inline bool isCharClass(char c, uint8_t classes) {
+    return CHAR_CLASSES[static_cast<unsigned char>(c)] & classes;
+}
+
+#endif
@@ -0,0 +1,256 @@
+/**
+ * @file CompactTree.cpp
+ * @brief Implementation file for the CompactTree class
+ * @authors Jacob Franco, Zach Gassner, Haley Joerger, Adam Lyday
+ */
+
+#include "CompactTree.hpp"
+#include "TreeCursor.hpp"
+#include <sstream>
+#include <thread>
+
+/**
+ * @brief Returns the token of the node pointed at
+ */
+Token CompactCursor::token() const {
+    return (*tree->tokens)[tree->nodes[node].token];
+}
+
+/**
+ * @brief Returns a cursor at the left child of the node pointed at
+ */
+CompactCursor CompactCursor::leftChild() const {
+    return CompactCursor(tree, tree->nodes[node].leftChild);
+}
+
+/**
+ * @brief Returns a cursor at the right sibling of the node pointed at
+ */
+CompactCursor CompactCursor::rightSibling() const {
+    return CompactCursor(tree, tree->nodes[node].rightSibling);
+}
+
+/**
+ * @brief Returns true if a top-level declaration can start with type
+ */
+static bool startsDeclaration(TokenType type) {
+    switch (type) {
+        case KEYWORD_FUNCTION:
+        case KEYWORD_PROCEDURE:
+        case KEYWORD_INT:
+        case KEYWORD_STRING:
+        case CHAR:
+        case KEYWORD_BOOL:
+            return true;
+
+        default:
+            return false;
+    }
+}
+
+/**
+ * @brief Splits a program into chunks of about the same size between 
+ *        top-level declarations
+ * @param tokens - The tokens of the program
+ * @param chunkCount - The most chunks to split it into
+ * @returns The index of the first token of each chunk, then the number of 
+ *          tokens
+ * @remark Only matches braces, so a chunk may start in the wrong place in a 
+ *         program the DFA reads differently; see buildInParallel
+ */
+static vector<uint32_t> findChunkStarts(const TokenStream& tokens, 
+                                        size_t chunkCount) {
+    vector<uint32_t> starts(1, 0);
+    size_t size = tokens.size();
+    int depth = 0;
+
+    for (size_t i = 1; i < size && starts.size() < chunkCount; i++) {
+        TokenType previous = tokens.type(i - 1);
+
+        // a declaration starts after the } of a body or the ; of a global,
+        // outside of every block
+        if (previous == LEFT_BRACE)
+            depth++;
+        else if (previous == RIGHT_BRACE)
+            depth--;
+        else if (previous != SEMICOLON)
+            continue;
+
+        if (depth == 0 && i >= starts.size() * size / chunkCount && 
+            startsDeclaration(tokens.type(i)))
+            starts.push_back(i);
+    }
+
+    starts.push_back(size);
+    return starts;
+}
+
+/**
+ * @brief Constructor
+ * @param tokens - The tokens of a C-style program
+ * @param threads - How many threads may build the tree
+ */
+CompactTree::CompactTree(const TokenStream& tokens, unsigned threads) 
+    : tokens(&tokens) {
+    nodes.resize(tokens.size());
+    buildInParallel(threads);
+}
+
+/**
+ * @brief Builds the nodes of the tokens from first up to last, linking each 
+ *        to the node before it except the first
+ * @param dfa - The DFA, after the token before first
+ * @param table - Receives the statements of the tokens
+ * @returns True if the first token starts a statement
+ */
+bool CompactTree::build(uint32_t first, uint32_t last, StatementDFA& dfa,
+                        StatementTable<CompactCursor>& table) {
+    bool startsFirst = false;
+
+    // every token gets the next node, so a node is linked into the tree by
+    // the node of the token before it
+    for (uint32_t i = first; i < last; i++) {
+        TokenType type = tokens->type(i);
+        bool startsStatement = dfa.startsStatement(type);
+        nodes[i] = CompactNode{i, NO_NODE, NO_NODE};
+        table.addToken(type, startsStatement, CompactCursor(this, i));
+
+        if (i == first)
+            startsFirst = startsStatement;
+        else
+            link(i, startsStatement);
+    }
+
+    return startsFirst;
+}
+
+/**
+ * @brief Links the node of the token at index to the node before it
+ * @param startsStatement - True if the token starts a statement
+ */
+void CompactTree::link(uint32_t index, bool startsStatement) {
+    if (startsStatement)
+        nodes[index - 1].leftChild = index;
+    else
+        nodes[index - 1].rightSibling = index;
+}
+
+/**
+ * @brief Builds the tree in chunks on separate threads, then links them
+ * @param threads - The most chunks to build at once
+ * @remark Every chunk but the first is built on the guess that the DFA 
+ *         starts it the way it starts a program, which holds at a top-level 
+ *         declaration unless parentheses before it are left open. The guess 
+ *         is checked against the DFA the chunk before it ended with, and a 
+ *         chunk that was started wrong is built again from there.
+ */
+void CompactTree::buildInParallel(unsigned threads) {
+    size_t chunkCount = min<size_t>(threads, 
+                                    nodes.size() / PARALLEL_CHUNK_MIN_TOKENS);
+    StatementDFA dfa;
+
+    if (chunkCount <= 1) {
+        build(0, nodes.size(), dfa, statements);
+        return;
+    }
+
+    vector<uint32_t> starts = findChunkStarts(*tokens, chunkCount);
+    chunkCount = starts.size() - 1;
+
+    // the first chunk is built straight into the tree's DFA and statements,
+    // and every other chunk on its own, to be appended after it
+    struct Chunk {
+        StatementDFA dfa;
+        StatementTable<CompactCursor> statements;
+    };
+
+    vector<Chunk> chunks;
+    vector<thread> workers;
+    chunks.reserve(chunkCount - 1);
+    workers.emplace_back([this, &starts, &dfa] {
+        build(starts[0], starts[1], dfa, statements);
+    });
+
+    for (size_t k = 1; k < chunkCount; k++) {
+        chunks.push_back(Chunk{StatementDFA(), 
+                               StatementTable<CompactCursor>(starts[k])});
+        workers.emplace_back([this, &starts, &chunks, k] {
+            build(starts[k], starts[k + 1], chunks[k - 1].dfa, 
+                  chunks[k - 1].statements);
+        });
+    }
+
+    for (thread& worker : workers)
+        worker.join();
+
+    for (size_t k = 1; k < chunkCount; k++) {
+        TokenType first = tokens->type(starts[k]);
+        StatementDFA started;
+        started.startsStatement(first);
+
+        // the chunk before ended where a fresh DFA would be, so this chunk 
+        // came out as if the whole program had been built at once
+        StatementDFA resumed = dfa;
+
+        if (!(resumed.startsStatement(first) && resumed == started)) {
+            link(starts[k], build(starts[k], starts[k + 1], dfa, statements));
+            continue;
+        }
+
+        link(starts[k], true);
+        statements.append(chunks[k - 1].statements);
+        dfa = chunks[k - 1].dfa;
+    }
+}
+
+/**
+ * @brief Returns a cursor at the first node of the first statement, or at 
+ *        no node for a program without tokens
+ */
+CompactCursor CompactTree::getRoot() const {
+    return CompactCursor(this, nodes.empty() ? NO_NODE : 0);
+}
+
+/**
+ * @brief Getter for tokens private variable
+ * @returns The tokens the nodes point at
+ */
+const TokenStream& CompactTree::getTokens() const {
+    return *tokens;
+}
+
+/**
+ * @brief Getter for nodes private variable
+ * @returns Every node
+ */
+const vector<CompactNode>& CompactTree::getNodes() const {
+    return nodes;
+}
+
+/**
+ * @brief Getter for statements private variable
+ * @returns Every statement of the tree
+ */
+const StatementTable<CompactCursor>& CompactTree::getStatements() const {
+    return statements;
+}
+
+/**
+ * @brief Breadth-first search function
+ * @returns A string with the resulting BFS
+ */
+string CompactTree::BFS() const {
+    ostringstream result;
+    printLevelOrder(result, getRoot());
+    return result.str();
+}
+
+/**
+ * @brief Output operator overload
+ * @param os - The output stream operator
+ * @param obj - The CompactTree object to output
+ * @returns The modified output stream
+ */
+ostream& operator << (ostream& os, const CompactTree& obj) {
+    return printLevelOrder(os, obj.getRoot());
+}
@@ -0,0 +1,196 @@
+/**
+ * @file CompactTree.hpp
+ * @brief Defines the CompactTree class, a CST kept in one array of nodes
+ * @authors Jacob Franco, Zach Gassner, Haley Joerger, Adam Lyday
+ */
+
+#ifndef COMPACT_TREE_HPP
+#define COMPACT_TREE_HPP
+
+#include <cstdint>
+#include <iostream>
+#include <string>
+#include <vector>
+#include "Tokenization.hpp"
+#include "StatementTable.hpp"
+#include "RecursiveDescentParser.hpp"
+
+using namespace std;
+
+/**
+ * @brief The index of no node, in place of a null pointer
+ */
+const uint32_t NO_NODE = UINT32_MAX;
+
+/**
+ * @brief A CST is only built in chunks of at least this many tokens, so that
+ *        starting a thread pays off
+ */
+const size_t PARALLEL_CHUNK_MIN_TOKENS = 1 << 16;
+
+/**
+ * @struct CompactNode
+ * @brief One node of a CompactTree: indices in place of the LCRS token and 
+ *        pointers
+ * @remark token is the node's index in the TokenStream, so the tree holds no
+ *         pointers and can be written out as it is
+ */
+struct CompactNode {
+    uint32_t token;
+    uint32_t leftChild;
+    uint32_t rightSibling;
+};
+
+static_assert(sizeof(CompactNode) == 12, "CompactNode should be 12 bytes");
+
+class CompactTree;
+
+/**
+ * @class CompactCursor
+ * @brief Walks a CompactTree; see TreeCursor.hpp
+ */
+class CompactCursor {
+public:
+    /**
+     * @brief Constructor
+     * @param tree - The tree walked
+     * @param node - The index of the node to point at, or NO_NODE
+     */
+    CompactCursor(const CompactTree* tree = nullptr, uint32_t node = NO_NODE)
+        : tree(tree), node(node) { }
+
+    explicit operator bool () const { return node != NO_NODE; }
+    Token token() const;
+    CompactCursor leftChild() const;
+    CompactCursor rightSibling() const;
+
+private:
+    /**
+     * @brief The tree walked
+     */
+    const CompactTree* tree;
+
+    /**
+     * @brief The index of the node pointed at
+     */
+    uint32_t node;
+};
+
+/**
+ * @class CompactTree
+ * @brief The same CST RecursiveDescentParser builds, in one array of 12-byte
+ *        nodes that point at each other and at their tokens by index
+ * @remark An LCRS node is a whole Token and two pointers, more than three 
+ *         times the size. The tree is built in one pass over the tokens 
+ *         without allocating more than the array, and is never freed node by 
+ *         node.
+ * @remark Node i only ever points at nodes after it, so a large program is 
+ *         built in chunks on separate threads, split between top-level 
+ *         declarations, and the chunks are linked up afterwards.
+ */
+class CompactTree {
+public:
+    /**
+     * @brief Constructor
+     * @param tokens - The tokens of a C-style program
+     * @param threads - How many threads may build the tree
+     * @remark tokens have to outlive the tree
+     */
+    CompactTree(const TokenStream& tokens, unsigned threads = 1);
+
+    /**
+     * @brief The statements point back at the tree, so it cannot be copied
+     */
+    CompactTree(const CompactTree&) = delete;
+    CompactTree& operator = (const CompactTree&) = delete;
+
+    /**
+     * @brief Returns a cursor at the first node of the first statement, or 
+     *        at no node for a program without tokens
+     */
+    CompactCursor getRoot() const;
+
+    /**
+     * @brief Getter for tokens private variable
+     * @returns The tokens the nodes point at
+     */
+    const TokenStream& getTokens() const;
+
+    /**
+     * @brief Getter for nodes private variable
+     * @returns Every node, the root first and each node after its parent or 
+     *          left sibling
+     */
+    const vector<CompactNode>& getNodes() const;
+
+    /**
+     * @brief Getter for statements private variable
+     * @returns Every statement of the tree, recorded as it was built
+     */
+    const StatementTable<CompactCursor>& getStatements() const;
+
+    /**
+     * @brief Breadth-first search function
+     * @returns A string with the resulting BFS
+     * @remark The same string LCRS::BFS gives for the same program
+     */
+    string BFS() const;
+
+    /**
+     * @brief Output operator overload
+     * @param os - The output stream operator
+     * @param obj - The CompactTree object to output
+     * @returns The modified output stream
+     * @remark Outputs the BFS of the tree
+     *
+     *      ex: cout << CompactTreeObj;
+     */
+    friend ostream& operator << (ostream& os, const CompactTree& obj);
+
+private:
+    /**
+     * @brief Builds the nodes of the tokens from first up to last, linking
+     *        each to the node before it except the first
+     * @param dfa - The DFA, after the token before first
+     * @param table - Receives the statements of the tokens
+     * @returns True if the first token starts a statement
+     * @remark Touches no node outside the range, so ranges can be built at 
+     *         the same time
+     */
+    bool build(uint32_t first, uint32_t last, StatementDFA& dfa, 
+               StatementTable<CompactCursor>& table);
+
+    /**
+     * @brief Links the node of the token at index to the node before it
+     * @param startsStatement - True if the token starts a statement
+     */
+    void link(uint32_t index, bool startsStatement);
+
+    /**
+     * @brief Builds the tree in chunks on separate threads, then links them
+     * @param threads - The most chunks to build at once
+     */
+    void buildInParallel(unsigned threads);
+
+    /**
+     * @brief The tokens the nodes point at
+     */
+    const TokenStream* tokens;
+
+    /**
+     * @brief Every node; node i holds token i
+     */
+    vector<CompactNode> nodes;
+
+    /**
+     * @brief Every statement of the tree
+     */
+    StatementTable<CompactCursor> statements;
+
+    /**
+     * @brief So CompactCursor can follow the indices
+     */
+    friend class CompactCursor;
+};
+
+#endif
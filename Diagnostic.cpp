@@ -0,0 +1,60 @@
+/**
+ * @file Diagnostic.cpp
+ * @brief Implementation file for the Diagnostic struct
+ * @authors Jacob Franco, Zach Gassner, Haley Joerger, Adam Lyday
+ */
+
+#include "Diagnostic.hpp"
+#include <cstdlib>
+
+/**
+ * @brief Returns true if the lexer or a parser found the error
+ */
+bool isSyntaxError(const Diagnostic& diagnostic) {
+    return diagnostic.code != DIAGNOSTIC_REDEFINED_VARIABLE &&
+           diagnostic.code != DIAGNOSTIC_DAMAGED_TOKEN_CACHE &&
+           diagnostic.code != DIAGNOSTIC_PROGRAM_TOO_LARGE;
+}
+
+/**
+ * @brief Writes a diagnostic to the stream the front end has always written
+ *        it to: cout for an invalid integer, cerr for everything else
+ */
+void printDiagnostic(const Diagnostic& diagnostic) {
+    if (diagnostic.code == DIAGNOSTIC_INVALID_INTEGER)
+        cout << diagnostic;
+    else
+        cerr << diagnostic;
+}
+
+/**
+ * @brief Returns the exit status of a run that ends on the diagnostic
+ */
+int getExitStatus(const Diagnostic& diagnostic) {
+    switch (diagnostic.code) {
+        // the project specs expect these to end the run successfully
+        case DIAGNOSTIC_INVALID_INTEGER:
+        case DIAGNOSTIC_RESERVED_WORD:
+        case DIAGNOSTIC_REDEFINED_VARIABLE:
+            return 0;
+
+        default:
+            return EXIT_FAILURE;
+    }
+}
+
+/**
+ * @brief Output operator overload
+ * @param os - The output stream operator
+ * @param obj - The Diagnostic object to output
+ * @returns The modified output stream
+ */
+ostream& operator << (ostream& os, const Diagnostic& obj) {
+    os << (isSyntaxError(obj) ? "Syntax error" : "Error");
+
+    if (obj.line > 0)
+        os << " on line " << obj.line;
+
+    os << ": " << obj.message << '\n';
+    return os;
+}
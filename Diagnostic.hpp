@@ -0,0 +1,82 @@
+/**
+ * @file Diagnostic.hpp
+ * @brief Defines the Diagnostic struct that a stage returns when it rejects
+ *        a program, instead of exiting
+ * @authors Jacob Franco, Zach Gassner, Haley Joerger, Adam Lyday
+ */
+
+#ifndef DIAGNOSTIC_HPP
+#define DIAGNOSTIC_HPP
+
+#include <iostream>
+#include <string>
+
+using namespace std;
+
+/**
+ * @enum DiagnosticCode
+ * @brief Enumerates the errors a program can be rejected for
+ */
+enum DiagnosticCode {
+    DIAGNOSTIC_INVALID_UTF8,
+    DIAGNOSTIC_UNTERMINATED_STRING,
+    DIAGNOSTIC_NEGATIVE_ARRAY_SIZE,
+    DIAGNOSTIC_INVALID_INTEGER,
+    DIAGNOSTIC_RESERVED_WORD,
+    // a character outside any literal that starts no token
+    DIAGNOSTIC_INVALID_CHARACTER,
+    // a token the grammar does not allow, found by PredictiveParser
+    DIAGNOSTIC_UNEXPECTED_TOKEN,
+    DIAGNOSTIC_REDEFINED_VARIABLE,
+    // not an error in the program: a token cache that cannot be read
+    DIAGNOSTIC_DAMAGED_TOKEN_CACHE,
+    // not an error in the program: one too large for 32-bit offsets
+    DIAGNOSTIC_PROGRAM_TOO_LARGE,
+};
+
+/**
+ * @struct Diagnostic
+ * @brief An error found in a program, with the line it is on; line is 0 
+ *        for errors that are not on any line
+ * @remark The stage that finds an error stops and keeps it, and the caller
+ *         decides whether to print it, give up on the program or go on to
+ *         the next one
+ */
+struct Diagnostic {
+    DiagnosticCode code;
+    int line;
+    string message;
+};
+
+/**
+ * @brief Returns true if the lexer or a parser found the error
+ */
+bool isSyntaxError(const Diagnostic& diagnostic);
+
+/**
+ * @brief Writes a diagnostic to the stream the front end has always written
+ *        it to: cout for an invalid integer, cerr for everything else
+ */
+void printDiagnostic(const Diagnostic& diagnostic);
+
+/**
+ * @brief Returns the exit status of a run that ends on the diagnostic
+ * @remark 0 for an invalid integer, a reserved word used as a name and a 
+ *         redefined variable, as the project specs expect, and EXIT_FAILURE
+ *         for everything else
+ */
+int getExitStatus(const Diagnostic& diagnostic);
+
+/**
+ * @brief Output operator overload
+ * @param os - The output stream operator
+ * @param obj - The Diagnostic object to output
+ * @returns The modified output stream
+ * @remark Outputs one line, like
+ *
+ *      Syntax error on line 3: invalid integer
+ *      Error: the token cache is damaged.
+ */
+ostream& operator << (ostream& os, const Diagnostic& obj);
+
+#endif
@@ -0,0 +1,58 @@
+/**
+ * @file IdentifierTable.cpp
+ * @brief Implementation file for the IdentifierTable class
+ * @authors Jacob Franco, Zach Gassner, Haley Joerger, Adam Lyday
+ */
+
+#include "IdentifierTable.hpp"
+
+/**
+ * @brief Constructor
+ * @remark Takes SymbolId 0 for the empty name
+ */
+IdentifierTable::IdentifierTable() : names(1) {
+    symbols.emplace(names.front(), NO_SYMBOL);
+}
+
+/**
+ * @brief Returns the table of the program being analyzed
+ */
+IdentifierTable& IdentifierTable::get() {
+    static IdentifierTable table;
+    return table;
+}
+
+/**
+ * @brief Forgets every name, so that the next program starts numbering its
+ *        names from 1 again
+ * @remark Keeps the empty name as NO_SYMBOL
+ */
+void IdentifierTable::reset() {
+    symbols.clear();
+    names.resize(1);
+    symbols.emplace(names.front(), NO_SYMBOL);
+}
+
+/**
+ * @brief Returns the number of a name, adding the name if it is new
+ * @param name - The characters of the name
+ */
+SymbolId IdentifierTable::intern(string_view name) {
+    auto found = symbols.find(name);
+
+    if (found != symbols.end())
+        return found->second;
+
+    names.emplace_back(name);
+    SymbolId symbol = names.size() - 1;
+    symbols.emplace(names.back(), symbol);
+    return symbol;
+}
+
+/**
+ * @brief Returns the characters of an interned name
+ * @param symbol - A number returned by intern
+ */
+string_view IdentifierTable::getName(SymbolId symbol) const {
+    return names[symbol];
+}
@@ -0,0 +1,96 @@
+/**
+ * @file IdentifierTable.hpp
+ * @brief Defines the IdentifierTable class that gives every distinct name in
+ *        a compilation a number
+ * @authors Jacob Franco, Zach Gassner, Haley Joerger, Adam Lyday
+ */
+
+#ifndef IDENTIFIER_TABLE_HPP
+#define IDENTIFIER_TABLE_HPP
+
+#include <cstdint>
+#include <deque>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+
+using namespace std;
+
+/**
+ * @brief The number of an interned name
+ */
+typedef uint32_t SymbolId;
+
+/**
+ * @brief The SymbolId of tokens that are not words
+ */
+const SymbolId NO_SYMBOL = 0;
+
+/**
+ * @class IdentifierTable
+ * @brief Stores each distinct name once and numbers it, so that names can be
+ *        compared and hashed as integers
+ * @remark There is one table, shared by every stage, so a name has the 
+ *         same SymbolId in every token and symbol table entry of a program.
+ *         The table only lives as long as one program: main resets it 
+ *         before each program, so it never holds more names than the 
+ *         program being analyzed, and a SymbolId or name from an earlier 
+ *         program must not be used after that. It takes no lock: only the thread that 
+ *         lexes interns names (chunk lexers leave it to the thread that puts
+ *         the chunks together), and the stages after the lexer read the 
+ *         SymbolId off each token instead of interning again
+ */
+class IdentifierTable {
+public:
+    /**
+     * @brief Returns the table of the program being analyzed
+     */
+    static IdentifierTable& get();
+
+    /**
+     * @brief Forgets every name, so that the next program starts numbering
+     *        its names from 1 again
+     * @remark Every SymbolId and name returned before are invalid afterwards
+     */
+    void reset();
+
+    /**
+     * @brief Returns the number of a name, adding the name if it is new
+     * @param name - The characters of the name
+     */
+    SymbolId intern(string_view name);
+
+    /**
+     * @brief Returns the characters of an interned name
+     * @param symbol - A number returned by intern
+     * @remark The characters stay valid until the table is reset
+     */
+    string_view getName(SymbolId symbol) const;
+
+    /**
+     * @brief The table is shared, so it cannot be copied
+     */
+    IdentifierTable(const IdentifierTable&) = delete;
+    IdentifierTable& operator = (const IdentifierTable&) = delete;
+
+private:
+    /**
+     * @brief Constructor
+     * @remark Takes SymbolId 0 for the empty name, so that NO_SYMBOL never
+     *         belongs to a real name
+     */
+    IdentifierTable();
+
+    /**
+     * @brief Every name, in the order they were added; a deque so that
+     *        adding a name never moves the others
+     */
+    deque<string> names;
+
+    /**
+     * @brief The number of every name; the keys point into names
+     */
+    unordered_map<string_view, SymbolId> symbols;
+};
+
+#endif
@@ -5,26 +5,118 @@
  */
 
 #include "IgnoreComments.hpp"
+#include "SimdScan.hpp"
+#include <algorithm>
+#include <cstring>
+
+/**
+ * @brief The characters that can move the DFA out of ANYTHING,
+ *        SINGLE_LINE_COMMENT or MULTI_LINE_COMMENT
+ * @remark Every other character in those states is copied (ANYTHING) or
+ *          blanked (comments) without a transition, so the DFA fast-forwards
+ *          from one of these to the next
+ */
+static const char stopCharacters[] = { '\n', '*', '/', '"', '\'' };
+
+/**
+ * @brief A block's worth of the character that replaces comments
+ */
+static const string blanks(SCAN_BLOCK_SIZE, ' ');
 
 /**
  * @brief Constructor
  * @param fileName - The name of a file that contains a C-style program
- * @remark Opens the file and runs it through a DFA to construct object with 
+ * @remark Maps the file and runs it through a DFA to construct object with 
  *          comments ignored
  */
 IgnoreComments::IgnoreComments(const string& fileName) {
-    ifstream inputFile(fileName.c_str());
+    SourceBuffer source(fileName);
 
-    if (!inputFile) {
+    if (!source.isOpen()) {
         cerr << "Error. Unable to open the file :( \n";
     }
 
+    strip(source.data(), source.size());
+}
+
+/**
+ * @brief Constructor
+ * @param input - The first character of a C-style program
+ * @param size - The number of characters in the program
+ * @remark Runs an in-memory program through the DFA to construct object with
+ *          comments ignored
+ */
+IgnoreComments::IgnoreComments(const char* input, size_t size) {
+    strip(input, size);
+}
+
+/**
+ * @brief Runs the comment DFA over a buffer and stores the output in result
+ * @param input - The first character of a C-style program
+ * @param size - The number of characters in the program
+ * @remark The output is never longer than the input, so result is sized
+ *          once up front and written through a pointer. In the states where
+ *          most characters pass straight through, the next stop character
+ *          is found with a block mask from matchBlock and the run before it
+ *          is copied or blanked in bulk; the switch below still makes every
+ *          state transition.
+ */
+void IgnoreComments::strip(const char* input, size_t size) {
+    result.resize(size);
+    char* out = result.data();
+    lineIndex.clear();
+
     State state = ANYTHING;
     int line = 1; 
     int mult_line = 0;
-    char currentChar;
 
-    while (inputFile.get(currentChar)) {
+    // stop masks for the block of input starting at maskedBlock
+    uint64_t masks[sizeof(stopCharacters)];
+    size_t maskedBlock = size;
+
+    for (size_t i = 0; i < size; i++) {
+        while (state == ANYTHING || state == SINGLE_LINE_COMMENT || 
+               state == MULTI_LINE_COMMENT) {
+            size_t block = i & ~(SCAN_BLOCK_SIZE - 1);
+            size_t blockEnd = min(block + SCAN_BLOCK_SIZE, size);
+
+            if (block != maskedBlock) {
+                matchBlock(input + block, blockEnd - block, stopCharacters, 
+                           sizeof(stopCharacters), masks);
+                maskedBlock = block;
+            }
+
+            uint64_t stops = masks[0];
+
+            if (state != SINGLE_LINE_COMMENT)
+                stops |= masks[1];
+            if (state == ANYTHING)
+                stops |= masks[2] | masks[3] | masks[4];
+
+            stops >>= i - block;
+            size_t run = stops ? __builtin_ctzll(stops) : blockEnd - i;
+
+            const char* from = state == ANYTHING ? input + i : blanks.data();
+
+            // a fixed-size block store beats a variable-length copy; whatever
+            // lands past the run is overwritten by the characters after it
+            if (i + SCAN_BLOCK_SIZE <= size)
+                memcpy(out, from, SCAN_BLOCK_SIZE);
+            else
+                memcpy(out, from, run);
+
+            out += run;
+            i += run;
+
+            if (stops || i == size)
+                break;
+        }
+
+        if (i == size)
+            break;
+
+        char currentChar = input[i];
+        char nextChar = i + 1 < size ? input[i + 1] : '\0';
 
         switch (state) {
 
@@ -32,23 +124,21 @@ IgnoreComments::IgnoreComments(const string& fileName) {
             case ANYTHING:
                 if (currentChar == '/') {
                     state = SLASH;
-                    char nextChar = inputFile.peek();
-                    result += (nextChar == '/' || nextChar == '*') ? ' ' : currentChar;
+                    *out++ = (nextChar == '/' || nextChar == '*') ? ' ' : currentChar;
                 } else if (currentChar == '"') {
                     state = State::DOUBLE_QUOTE;
-                    result += currentChar;
+                    *out++ = currentChar;
                 } else if (currentChar == '\'') {
                     state = State::SINGLE_QUOTE;
-                    result += currentChar;
+                    *out++ = currentChar;
                 } else if (currentChar == '\n'){ //Check for new line
-                    result += currentChar;
+                    *out++ = currentChar;
                     line += 1; 
                 } else if (currentChar == '*'){  // Check if */ appears before /* 
-                    char nextChar = inputFile.peek();
                     state = (nextChar == '/') ? ERROR : ANYTHING;
-                    result += currentChar;
+                    *out++ = currentChar;
                 } else {
-                    result += currentChar;
+                    *out++ = currentChar;
                 }
                 break;
             
@@ -56,13 +146,13 @@ IgnoreComments::IgnoreComments(const string& fileName) {
             case SLASH:
                 if (currentChar == '/') {
                     state = SINGLE_LINE_COMMENT;
-                    result += ' ';
+                    *out++ = ' ';
                 } else if (currentChar == '*') {
                     state = MULTI_LINE_COMMENT;
-                    result += ' ';
+                    *out++ = ' ';
                 } else {
                     state = ANYTHING;
-                    result += currentChar;
+                    *out++ = currentChar;
                 }
                 break;
 
@@ -70,14 +160,14 @@ IgnoreComments::IgnoreComments(const string& fileName) {
             case ASTERICK:
                 if (currentChar == '/') {
                     state = ANYTHING;
-                    result += ' ';
+                    *out++ = ' ';
                 } else if (currentChar == '\n'){
                     line++; 
                     state = MULTI_LINE_COMMENT;
-                    result += '\n';
+                    *out++ = '\n';
                 } else if (currentChar != '*') {
                     state = MULTI_LINE_COMMENT;
-                    result += ' ';
+                    *out++ = ' ';
                 } 
                 break;
 
@@ -86,9 +176,9 @@ IgnoreComments::IgnoreComments(const string& fileName) {
                 if (currentChar == '\n') {
                     line++; 
                     state = ANYTHING;
-                    result += currentChar;
+                    *out++ = currentChar;
                 } else {
-                    result += ' ';
+                    *out++ = ' ';
                 }
                 break;
 
@@ -96,10 +186,10 @@ IgnoreComments::IgnoreComments(const string& fileName) {
             case MULTI_LINE_COMMENT:
                 if (currentChar == '*') {
                     state = ASTERICK;
-                    result += ' ';
+                    *out++ = ' ';
                 } else {
                     line  += currentChar == '\n' ? 1 : 0 ;  
-                    result += currentChar == '\n' ? '\n' : ' ';
+                    *out++ = currentChar == '\n' ? '\n' : ' ';
                     mult_line += currentChar == '\n' ? 1 : 0 ;
                     
                 } 
@@ -110,21 +200,32 @@ IgnoreComments::IgnoreComments(const string& fileName) {
                 if (currentChar == '\'') {
                     state = ANYTHING;
                 }
-                result += currentChar;
+                *out++ = currentChar;
                 break;
 
             case DOUBLE_QUOTE:
                 if (currentChar == '"') {
                     state = ANYTHING;
                 } 
-                result += currentChar;
+                *out++ = currentChar;
                 break;
 
             case ERROR:
                 break;
         }
+
+        // every newline is copied to the output, even inside comments
+        if (currentChar == '\n' && state != ERROR)
+            lineIndex.addLineStart(out - result.data());
     }
 
+    result.resize(out - result.data());
+
+    error = state == ERROR || state == MULTI_LINE_COMMENT;
+
+    if (error)
+        lineIndex.clear();
+
     if (state == ERROR) {
 
         result = "ERROR: Program contains C-style, unterminated comment on line "
@@ -138,8 +239,6 @@ IgnoreComments::IgnoreComments(const string& fileName) {
                 + to_string(line - mult_line);
                 
     }
-
-    inputFile.close(); 
 }
 
 /**
@@ -154,4 +253,28 @@ IgnoreComments::IgnoreComments(const string& fileName) {
 ostream& operator << (ostream& os, const IgnoreComments& obj) {
     os << obj.result;
     return os;
+}
+
+/**
+ * @brief Getter for result private variable
+ * @returns The input program with comments ignored, without copying it
+ */
+const string& IgnoreComments::getResult() const {
+    return result;
+}
+
+/**
+ * @brief Returns true if result holds an unterminated comment error
+ *        instead of the program
+ */
+bool IgnoreComments::hasError() const {
+    return error;
+}
+
+/**
+ * @brief Getter for lineIndex private variable
+ * @returns Where each line of result starts
+ */
+const LineIndex& IgnoreComments::getLineIndex() const {
+    return lineIndex;
 }
\ No newline at end of file
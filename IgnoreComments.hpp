@@ -7,8 +7,9 @@
 #ifndef IGNORE_COMMENTS_HPP
 #define IGNORE_COMMENTS_HPP
 
+#include "SourceBuffer.hpp"
+#include "LineIndex.hpp"
 #include <iostream>
-#include <fstream> //Including fstream and string allow us to read in the input file
 #include <string>
 
 using namespace std;
@@ -25,6 +26,13 @@ public:
      */
     IgnoreComments(const string& fileName);
 
+    /**
+     * @brief Constructor
+     * @param input - The first character of a C-style program
+     * @param size - The number of characters in the program
+     */
+    IgnoreComments(const char* input, size_t size);
+
     /**
      * @brief Output operator overload
      * @param os - The output stream operator
@@ -36,6 +44,24 @@ public:
      */
     friend ostream& operator << (ostream& os, const IgnoreComments& obj);
 
+    /**
+     * @brief Getter for result private variable
+     * @returns The input program with comments ignored, without copying it
+     */
+    const string& getResult() const;
+
+    /**
+     * @brief Returns true if result holds an unterminated comment error
+     *        instead of the program
+     */
+    bool hasError() const;
+
+    /**
+     * @brief Getter for lineIndex private variable
+     * @returns Where each line of result starts
+     */
+    const LineIndex& getLineIndex() const;
+
     /** 
      * @enum State
      * @brief Enumerates the states of the DFA
@@ -52,10 +78,27 @@ public:
     };
 
 private:
+    /**
+     * @brief Runs the comment DFA over a buffer and stores the output in result
+     * @param input - The first character of a C-style program
+     * @param size - The number of characters in the program
+     */
+    void strip(const char* input, size_t size);
+
     /**
      * @brief This string contains the input program with comments ignored
      */
     string result;
+
+    /**
+     * @brief True if the DFA ended in ERROR or MULTI_LINE_COMMENT
+     */
+    bool error;
+
+    /**
+     * @brief Where each line of result starts, recorded while stripping
+     */
+    LineIndex lineIndex;
 };
 
 #endif
\ No newline at end of file
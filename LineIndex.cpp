@@ -0,0 +1,71 @@
+/**
+ * @file LineIndex.cpp
+ * @brief Implementation file for the LineIndex class
+ * @authors Jacob Franco, Zach Gassner, Haley Joerger, Adam Lyday
+ */
+
+#include "LineIndex.hpp"
+#include "SimdScan.hpp"
+#include <algorithm>
+
+/**
+ * @brief Constructor
+ * @remark Starts with a single line at offset 0
+ */
+LineIndex::LineIndex() : lineStarts(1, 0) { }
+
+/**
+ * @brief Constructor
+ * @param data - The first character of a program
+ * @param size - The number of characters in the program
+ * @remark Finds the newlines 64 characters at a time with matchBlock
+ */
+LineIndex::LineIndex(const char* data, size_t size) {
+    build(data, size);
+}
+
+/**
+ * @brief Indexes another program, keeping the memory of the table
+ * @param data - The first character of a program
+ * @param size - The number of characters in the program
+ */
+void LineIndex::build(const char* data, size_t size) {
+    const char newline = '\n';
+    lineStarts.assign(1, 0);
+
+    for (size_t block = 0; block < size; block += SCAN_BLOCK_SIZE) {
+        uint64_t newlines;
+        matchBlock(data + block, min(SCAN_BLOCK_SIZE, size - block), &newline,
+                   1, &newlines);
+
+        while (newlines != 0) {
+            lineStarts.push_back(block + __builtin_ctzll(newlines) + 1);
+            newlines &= newlines - 1;
+        }
+    }
+}
+
+/**
+ * @brief Forgets every line but the first
+ */
+void LineIndex::clear() {
+    lineStarts.resize(1);
+}
+
+/**
+ * @brief Returns the line number (starting at 1) of the line that
+ *        contains offset
+ * @param offset - A byte offset in the program
+ */
+int LineIndex::getLineNumber(size_t offset) const {
+    return upper_bound(lineStarts.begin(), lineStarts.end(), offset) - 
+           lineStarts.begin();
+}
+
+/**
+ * @brief Returns the column number (starting at 1) of offset
+ * @param offset - A byte offset in the program
+ */
+int LineIndex::getColumn(size_t offset) const {
+    return offset - lineStarts[getLineNumber(offset) - 1] + 1;
+}
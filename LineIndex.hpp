@@ -0,0 +1,98 @@
+/**
+ * @file LineIndex.hpp
+ * @brief Defines the LineIndex class that maps byte offsets in a program to
+ *        line and column numbers
+ * @authors Jacob Franco, Zach Gassner, Haley Joerger, Adam Lyday
+ */
+
+#ifndef LINE_INDEX_HPP
+#define LINE_INDEX_HPP
+
+#include <cstdint>
+#include <vector>
+
+using namespace std;
+
+/**
+ * @class LineIndex
+ * @brief Sorted table of the offset each line starts at
+ * @remark Tokens only store their offset; line and column are looked up here
+ *         with a binary search when a diagnostic or printer needs them
+ */
+class LineIndex {
+public:
+    /**
+     * @brief Constructor
+     * @remark Starts with a single line at offset 0
+     */
+    LineIndex();
+
+    /**
+     * @brief Constructor
+     * @param data - The first character of a program
+     * @param size - The number of characters in the program
+     * @remark Finds the newlines 64 characters at a time with matchBlock
+     */
+    LineIndex(const char* data, size_t size);
+
+    /**
+     * @brief Indexes another program, keeping the memory of the table
+     * @param data - The first character of a program
+     * @param size - The number of characters in the program
+     */
+    void build(const char* data, size_t size);
+
+    /**
+     * @brief Records that a new line starts at offset
+     * @param offset - The offset just past a newline; must be no smaller 
+     *                 than every offset added before it
+     */
+    void addLineStart(size_t offset) { lineStarts.push_back(offset); }
+
+    /**
+     * @brief Records that count new lines all start at offset, as empty 
+     *        lines do when only their last line start matters
+     * @param offset - The offset for every new line; must be no smaller 
+     *                 than every offset added before it
+     * @param count - The number of lines to add
+     */
+    void addLineStarts(size_t offset, size_t count) {
+        lineStarts.insert(lineStarts.end(), count, offset);
+    }
+
+    /**
+     * @brief Forgets every line but the first
+     */
+    void clear();
+
+    /**
+     * @brief Returns the line number (starting at 1) of the line that
+     *        contains offset
+     * @param offset - A byte offset in the program
+     */
+    int getLineNumber(size_t offset) const;
+
+    /**
+     * @brief Returns the column number (starting at 1) of offset
+     * @param offset - A byte offset in the program
+     */
+    int getColumn(size_t offset) const;
+
+    /**
+     * @brief Returns the offset a line starts at
+     * @param line - A line number (starting at 1)
+     * @returns The offset, or SIZE_MAX if the program has fewer lines
+     */
+    size_t getLineStart(int line) const {
+        return size_t(line) <= lineStarts.size() ? lineStarts[line - 1] 
+                                                 : SIZE_MAX;
+    }
+
+private:
+    /**
+     * @brief The offset of the first character of every line
+     */
+    vector<uint32_t> lineStarts;
+};
+
+#endif
@@ -0,0 +1,115 @@
+/**
+ * @file Pipeline.cpp
+ * @brief Implementation file for the Pipeline class
+ * @authors Jacob Franco, Zach Gassner, Haley Joerger, Adam Lyday
+ */
+
+#include "Pipeline.hpp"
+#include <thread>
+
+/**
+ * @brief Constructor
+ * @param source - A C-style program that may still contain comments
+ * @remark Returns once every stage is done
+ */
+Pipeline::Pipeline(const SourceBuffer& source) 
+    : lexer(source), lineIndex(lexer.getLineIndex()), parser(lineIndex), 
+      symbolTable(lineIndex),
+      tokenBatches(TOKEN_BATCH_QUEUE_SIZE), statements(STATEMENT_QUEUE_SIZE) {
+    thread lexing(&Pipeline::lex, this);
+    thread parsing(&Pipeline::parse, this);
+    Statement<LCRSCursor> statement;
+
+    while (statements.pop(statement))
+        symbolTable.addStatement(statement);
+
+    lexing.join();
+    parsing.join();
+}
+
+/**
+ * @brief Getter for parser private variable
+ */
+const RecursiveDescentParser& Pipeline::getParser() const {
+    return parser;
+}
+
+/**
+ * @brief Getter for symbolTable private variable
+ */
+const SymbolTable& Pipeline::getSymbolTable() const {
+    return symbolTable;
+}
+
+/**
+ * @brief Returns true if any stage rejected the program
+ */
+bool Pipeline::hasError() const {
+    return lexer.hasError() || symbolTable.hasError();
+}
+
+/**
+ * @brief Returns the error the program was rejected for
+ */
+const Diagnostic& Pipeline::getDiagnostic() const {
+    return lexer.hasError() ? lexer.getDiagnostic() 
+                            : symbolTable.getDiagnostic();
+}
+
+/**
+ * @brief Lexer thread: sends every token to the parser thread in batches
+ * @remark A lexer error ends the tokens early. That includes the lexer 
+ *         restarting on IgnoreComments' error message, which always ends in 
+ *         an error.
+ */
+void Pipeline::lex() {
+    vector<Token> batch;
+    Token token;
+    batch.reserve(TOKEN_BATCH_SIZE);
+
+    while (lexer.next(token)) {
+        batch.push_back(move(token));
+
+        if (batch.size() == TOKEN_BATCH_SIZE) {
+            tokenBatches.push(move(batch));
+            batch.clear();
+            batch.reserve(TOKEN_BATCH_SIZE);
+        }
+    }
+
+    if (!batch.empty())
+        tokenBatches.push(move(batch));
+
+    tokenBatches.close();
+}
+
+/**
+ * @brief Parser thread: builds the CST and sends every statement to the 
+ *        symbol table once it is complete
+ * @remark A statement is complete when the first token of the next one is 
+ *         added, since that is the last time the parser touches its nodes
+ */
+void Pipeline::parse() {
+    vector<Token> batch;
+    const StatementTable<LCRSCursor>& table = parser.getStatements();
+
+    while (tokenBatches.pop(batch)) {
+        for (const Token& token : batch) {
+            // the statement table only grows on this thread, so the symbol 
+            // table is sent copies of the entries
+            if (parser.addToken(token) && table.size() > 1) {
+                Statement<LCRSCursor> complete = table[table.size() - 2];
+                statements.push(move(complete));
+            }
+        }
+    }
+
+    // the last statement may have been cut short by a lexer error, and is
+    // never looked at since the lexer error is the one reported
+    if (!table.empty() && !lexer.hasError()) {
+        Statement<LCRSCursor> last = table.back();
+        statements.push(move(last));
+    }
+
+    statements.close();
+}
@@ -0,0 +1,127 @@
+/**
+ * @file Pipeline.hpp
+ * @brief Defines the Pipeline class that runs the front end stages on their
+ *        own threads so that they overlap on a large program
+ * @authors Jacob Franco, Zach Gassner, Haley Joerger, Adam Lyday
+ */
+
+#ifndef PIPELINE_HPP
+#define PIPELINE_HPP
+
+#include "SourceBuffer.hpp"
+#include "Tokenization.hpp"
+#include "RecursiveDescentParser.hpp"
+#include "symboltable.hpp"
+#include "SpscQueue.hpp"
+#include <vector>
+
+using namespace std;
+
+/**
+ * @brief The number of tokens the lexer hands to the parser at a time
+ */
+const size_t TOKEN_BATCH_SIZE = 4096;
+
+/**
+ * @brief The number of token batches the lexer may get ahead of the parser
+ */
+const size_t TOKEN_BATCH_QUEUE_SIZE = 16;
+
+/**
+ * @brief The number of statements the parser may get ahead of the symbol
+ *        table
+ */
+const size_t STATEMENT_QUEUE_SIZE = 1024;
+
+/**
+ * @class Pipeline
+ * @brief Lexes, parses and builds the symbol table for a program at the same
+ *        time
+ * @remark The lexer thread (which also skips comments) sends batches of 
+ *         tokens to the parser thread, which sends each statement to the 
+ *         calling thread as soon as it is complete. The calling thread adds 
+ *         the statements to the symbol table. Every stage sees the same input
+ *         in the same order as when they run one after another, so the 
+ *         results and errors are the same. A stage that rejects the program
+ *         keeps draining its input, so the stages before it never block.
+ */
+class Pipeline {
+public:
+    /**
+     * @brief Constructor
+     * @param source - A C-style program that may still contain comments
+     * @remark Returns once every stage is done
+     */
+    Pipeline(const SourceBuffer& source);
+
+    /**
+     * @brief Getter for parser private variable
+     */
+    const RecursiveDescentParser& getParser() const;
+
+    /**
+     * @brief Getter for symbolTable private variable
+     */
+    const SymbolTable& getSymbolTable() const;
+
+    /**
+     * @brief Returns true if any stage rejected the program
+     */
+    bool hasError() const;
+
+    /**
+     * @brief Returns the error the program was rejected for
+     * @remark A lexer error comes first even when the symbol table found one
+     *         earlier in the program, the same as when the stages run one 
+     *         after another
+     */
+    const Diagnostic& getDiagnostic() const;
+
+private:
+    /**
+     * @brief Lexer thread: sends every token to the parser thread in batches
+     */
+    void lex();
+
+    /**
+     * @brief Parser thread: builds the CST and sends every statement to the 
+     *        symbol table once it is complete
+     */
+    void parse();
+
+    /**
+     * @brief Produces the tokens of the program
+     */
+    Lexer lexer;
+
+    /**
+     * @brief The lines of the program, for the parser and the symbol table
+     * @remark A copy of the lexer's, made before the lexer thread starts. The
+     *         lexer replaces its own when it restarts on IgnoreComments' 
+     *         error message, which would race with the other threads 
+     *         reading it.
+     */
+    LineIndex lineIndex;
+
+    /**
+     * @brief Builds the CST
+     */
+    RecursiveDescentParser parser;
+
+    /**
+     * @brief Built from the statements of the CST
+     */
+    SymbolTable symbolTable;
+
+    /**
+     * @brief Lexer thread to parser thread
+     */
+    SpscQueue<vector<Token>> tokenBatches;
+
+    /**
+     * @brief Parser thread to the symbol table
+     */
+    SpscQueue<Statement<LCRSCursor>> statements;
+};
+
+#endif
@@ -0,0 +1,774 @@
+/**
+ * @file PredictiveParser.cpp
+ * @brief Implementation file for the PredictiveParser class
+ * @authors Jacob Franco, Zach Gassner, Haley Joerger, Adam Lyday
+ */
+
+#include "PredictiveParser.hpp"
+#include <climits>
+
+/**
+ * @struct NestingGuard
+ * @brief Counts one more level of nesting for as long as it lives
+ */
+struct NestingGuard {
+    int& depth;
+
+    NestingGuard(int& depth) : depth(depth) { depth++; }
+    ~NestingGuard() { depth--; }
+};
+
+/**
+ * @brief Returns how tightly a binary operator binds, higher binding
+ *        tighter, or 0 for a token that is not a binary operator
+ */
+static int getBinaryPrecedence(TokenType type) {
+    switch (type) {
+        case BOOLEAN_OR_OPERATOR:
+            return 1;
+
+        case BOOLEAN_AND_OPERATOR:
+            return 2;
+
+        case BOOLEAN_EQUAL:
+        case BOOLEAN_NOT_EQUAL:
+            return 3;
+
+        case LT:
+        case GT:
+        case LT_EQUAL:
+        case GT_EQUAL:
+            return 4;
+
+        case PLUS:
+        case MINUS:
+            return 5;
+
+        case ASTERISK:
+        case DIVIDE:
+        case MODULO:
+            return 6;
+
+        case CARAT:
+            return 7;
+
+        default:
+            return 0;
+    }
+}
+
+/**
+ * @brief Returns the value of an array size, which the lexer has already
+ *        checked is a non-negative integer
+ * @remark Sizes too big for an int are cut down to INT_MAX
+ */
+static int getArraySize(string_view text) {
+    long long size = 0;
+
+    for (char c : text) {
+        if (c >= '0' && c <= '9')
+            size = min<long long>(size * 10 + (c - '0'), INT_MAX);
+    }
+
+    return int(size);
+}
+
+/**
+ * @brief Constructor
+ * @param tokens - The tokens of a C-style program
+ */
+PredictiveParser::PredictiveParser(const TokenStream& tokens)
+    : tokens(&tokens), position(0), depth(0), program(nullptr),
+      failed(false) {
+    Stmt** last = &program;
+
+    while (!atEnd()) {
+        *last = parseDeclaration();
+
+        if (failed)
+            break;
+
+        last = &(*last)->next;
+    }
+
+    if (failed)
+        program = nullptr;
+}
+
+/**
+ * @brief Getter for program private variable
+ * @returns The first top-level declaration, with the rest chained after it
+ */
+const Stmt* PredictiveParser::getProgram() const {
+    return program;
+}
+
+/**
+ * @brief Returns true if the program does not follow the grammar
+ */
+bool PredictiveParser::hasError() const {
+    return failed;
+}
+
+/**
+ * @brief Getter for diagnostic private variable
+ * @returns The syntax error the program was rejected for
+ */
+const Diagnostic& PredictiveParser::getDiagnostic() const {
+    return diagnostic;
+}
+
+/**
+ * @brief Moves past the next token if it has the given type
+ * @returns True if it did
+ */
+bool PredictiveParser::accept(TokenType type) {
+    if (!check(type))
+        return false;
+
+    position++;
+    return true;
+}
+
+/**
+ * @brief Moves past the next token, which has to have the given type
+ * @param type - The type the grammar needs next
+ * @param expected - What the grammar needs, for the error message
+ * @returns False, after rejecting the program, if the token is not of the
+ *          type
+ */
+bool PredictiveParser::expect(TokenType type, const char* expected) {
+    if (accept(type))
+        return true;
+
+    unexpected(expected);
+    return false;
+}
+
+/**
+ * @brief Rejects the program at the next token
+ * @param expected - What the grammar needs, for the error message
+ */
+void PredictiveParser::unexpected(const char* expected) {
+    if (failed)
+        return;
+
+    failed = true;
+    string message = string("expected ") + expected + " but found ";
+
+    if (atEnd()) {
+        message += "the end of the program.";
+        // the error is on the line of the last token
+        position = tokens->size() - 1;
+    } else {
+        message += "\"" + string(tokens->text(position)) + "\".";
+    }
+
+    diagnostic = Diagnostic{DIAGNOSTIC_UNEXPECTED_TOKEN,
+                            tokens->getLineNumber(position), message};
+    position = tokens->size();
+}
+
+/**
+ * @brief Returns true if type is a type keyword a variable can have
+ */
+bool PredictiveParser::isType(TokenType type) {
+    return type == KEYWORD_INT || type == CHAR || type == KEYWORD_BOOL ||
+           type == KEYWORD_STRING;
+}
+
+/**
+ * @brief program := { function | procedure | varDecl }
+ * @returns One declaration of the program
+ */
+Stmt* PredictiveParser::parseDeclaration() {
+    if (check(KEYWORD_FUNCTION) || check(KEYWORD_PROCEDURE))
+        return parseFunction();
+
+    if (!atEnd() && isType(tokens->type(position)))
+        return parseVarDecl();
+
+    unexpected("a function, procedure or variable declaration");
+    return nullptr;
+}
+
+/**
+ * @brief function := "function" type name "(" params ")" block
+ *        procedure := "procedure" name "(" params ")" block
+ */
+FunctionDecl* PredictiveParser::parseFunction() {
+    Token keyword = take();
+    bool isFunction = keyword.type == KEYWORD_FUNCTION;
+    FunctionDecl* function = newNode<FunctionDecl>(
+        isFunction ? SYNTAX_FUNCTION_DECL : SYNTAX_PROCEDURE_DECL,
+        keyword.offset);
+    function->returnType = VOID;
+
+    if (isFunction) {
+        if (atEnd() || !isType(tokens->type(position))) {
+            unexpected("a return type");
+            return function;
+        }
+
+        function->returnType = take().type;
+    }
+
+    if (!checkName()) {
+        unexpected(isFunction ? "the name of the function"
+                              : "the name of the procedure");
+        return function;
+    }
+
+    Token name = take();
+    function->name = name.character;
+    function->symbol = name.symbol;
+
+    if (!expect(LEFT_PARENTHESIS, "\"(\""))
+        return function;
+
+    function->parameters = parseParameters();
+
+    if (!expect(RIGHT_PARENTHESIS, "\")\""))
+        return function;
+
+    function->body = parseBlock();
+    return function;
+}
+
+/**
+ * @brief params := "void" | variable { "," variable }
+ * @returns The first parameter, or nullptr for (void)
+ */
+Variable* PredictiveParser::parseParameters() {
+    if (accept(VOID))
+        return nullptr;
+
+    Variable* first = nullptr;
+    Variable** last = &first;
+
+    do {
+        if (atEnd() || !isType(tokens->type(position))) {
+            unexpected("the type of a parameter");
+            return first;
+        }
+
+        *last = parseVariable(take().type);
+
+        if (failed)
+            return first;
+
+        last = &(*last)->next;
+    } while (accept(COMMA));
+
+    return first;
+}
+
+/**
+ * @brief variable := name [ "[" integer "]" ], after its type
+ * @param type - The type keyword before the variable
+ */
+Variable* PredictiveParser::parseVariable(TokenType type) {
+    if (!checkName()) {
+        unexpected("the name of a variable");
+        return nullptr;
+    }
+
+    Token name = take();
+    Variable* variable = newNode<Variable>(SYNTAX_VARIABLE, name.offset);
+    variable->type = type;
+    variable->name = name.character;
+    variable->symbol = name.symbol;
+
+    if (accept(LEFT_BRACKET)) {
+        if (!check(INTEGER)) {
+            unexpected("the size of the array");
+            return variable;
+        }
+
+        variable->isArray = true;
+        variable->arraySize = getArraySize(take().character);
+        expect(RIGHT_BRACKET, "\"]\"");
+    }
+
+    return variable;
+}
+
+/**
+ * @brief varDecl := type variable { "," variable } ";"
+ */
+VarDecl* PredictiveParser::parseVarDecl() {
+    Token type = take();
+    VarDecl* declaration = newNode<VarDecl>(SYNTAX_VAR_DECL, type.offset);
+    Variable** last = &declaration->variables;
+
+    do {
+        *last = parseVariable(type.type);
+
+        if (failed)
+            return declaration;
+
+        last = &(*last)->next;
+    } while (accept(COMMA));
+
+    expect(SEMICOLON, "\";\"");
+    return declaration;
+}
+
+/**
+ * @brief block := "{" { statement } "}"
+ */
+BlockStmt* PredictiveParser::parseBlock() {
+    if (!check(LEFT_BRACE)) {
+        unexpected("\"{\"");
+        return nullptr;
+    }
+
+    BlockStmt* block = newNode<BlockStmt>(SYNTAX_BLOCK_STMT,
+                                          take().offset);
+    Stmt** last = &block->statements;
+
+    while (!atEnd() && !check(RIGHT_BRACE)) {
+        *last = parseStatement();
+
+        if (failed)
+            return block;
+
+        last = &(*last)->next;
+    }
+
+    expect(RIGHT_BRACE, "\"}\"");
+    return block;
+}
+
+/**
+ * @brief statement := block | varDecl | if | for | while | return | printf
+ *                   | assign ";" | call ";"
+ */
+Stmt* PredictiveParser::parseStatement() {
+    NestingGuard guard(depth);
+
+    if (depth > MAX_NESTING_DEPTH) {
+        unexpected("fewer nested statements");
+        return nullptr;
+    }
+
+    if (atEnd()) {
+        unexpected("a statement");
+        return nullptr;
+    }
+
+    switch (tokens->type(position)) {
+        case LEFT_BRACE:
+            return parseBlock();
+
+        // "string" starts a declaration when a name follows it, and is
+        // the name of a variable otherwise
+        case KEYWORD_STRING:
+            if (checkName(1))
+                return parseVarDecl();
+            // fall through
+
+        case IDENTIFIER: {
+            Stmt* statement = parseAssignOrCall();
+            expect(SEMICOLON, "\";\"");
+            return statement;
+        }
+
+        case KEYWORD_INT:
+        case CHAR:
+        case KEYWORD_BOOL:
+            return parseVarDecl();
+
+        case KEYWORD_IF:
+            return parseIf();
+
+        case KEYWORD_FOR:
+            return parseFor();
+
+        case KEYWORD_WHILE:
+            return parseWhile();
+
+        case KEYWORD_RETURN:
+            return parseReturn();
+
+        case KEYWORD_PRINTF:
+            return parsePrintf();
+
+        default:
+            unexpected("a statement");
+            return nullptr;
+    }
+}
+
+/**
+ * @brief if := "if" "(" expr ")" statement [ "else" statement ]
+ */
+IfStmt* PredictiveParser::parseIf() {
+    IfStmt* ifStmt = newNode<IfStmt>(SYNTAX_IF_STMT, take().offset);
+
+    if (!expect(LEFT_PARENTHESIS, "\"(\""))
+        return ifStmt;
+
+    ifStmt->condition = parseExpr();
+
+    if (!expect(RIGHT_PARENTHESIS, "\")\""))
+        return ifStmt;
+
+    ifStmt->then = parseStatement();
+
+    if (accept(KEYWORD_ELSE))
+        ifStmt->otherwise = parseStatement();
+
+    return ifStmt;
+}
+
+/**
+ * @brief for := "for" "(" [ assign ] ";" [ expr ] ";" [ assign ] ")"
+ *               statement
+ */
+ForStmt* PredictiveParser::parseFor() {
+    ForStmt* forStmt = newNode<ForStmt>(SYNTAX_FOR_STMT, take().offset);
+
+    if (!expect(LEFT_PARENTHESIS, "\"(\""))
+        return forStmt;
+
+    if (!check(SEMICOLON))
+        forStmt->init = parseAssign();
+
+    if (!expect(SEMICOLON, "\";\""))
+        return forStmt;
+
+    if (!check(SEMICOLON))
+        forStmt->condition = parseExpr();
+
+    if (!expect(SEMICOLON, "\";\""))
+        return forStmt;
+
+    if (!check(RIGHT_PARENTHESIS))
+        forStmt->step = parseAssign();
+
+    if (!expect(RIGHT_PARENTHESIS, "\")\""))
+        return forStmt;
+
+    forStmt->body = parseStatement();
+    return forStmt;
+}
+
+/**
+ * @brief while := "while" "(" expr ")" statement
+ */
+WhileStmt* PredictiveParser::parseWhile() {
+    WhileStmt* whileStmt = newNode<WhileStmt>(SYNTAX_WHILE_STMT,
+                                              take().offset);
+
+    if (!expect(LEFT_PARENTHESIS, "\"(\""))
+        return whileStmt;
+
+    whileStmt->condition = parseExpr();
+
+    if (!expect(RIGHT_PARENTHESIS, "\")\""))
+        return whileStmt;
+
+    whileStmt->body = parseStatement();
+    return whileStmt;
+}
+
+/**
+ * @brief return := "return" [ expr ] ";"
+ */
+ReturnStmt* PredictiveParser::parseReturn() {
+    ReturnStmt* returnStmt = newNode<ReturnStmt>(SYNTAX_RETURN_STMT,
+                                                 take().offset);
+
+    if (!check(SEMICOLON))
+        returnStmt->value = parseExpr();
+
+    expect(SEMICOLON, "\";\"");
+    return returnStmt;
+}
+
+/**
+ * @brief printf := "printf" "(" string { "," expr } ")" ";"
+ */
+PrintfStmt* PredictiveParser::parsePrintf() {
+    PrintfStmt* printfStmt = newNode<PrintfStmt>(SYNTAX_PRINTF_STMT,
+                                                 take().offset);
+
+    if (!expect(LEFT_PARENTHESIS, "\"(\""))
+        return printfStmt;
+
+    if (!check(DOUBLE_QUOTE)) {
+        unexpected("a format string");
+        return printfStmt;
+    }
+
+    printfStmt->format = parseString();
+    Expr** last = &printfStmt->arguments;
+
+    while (accept(COMMA)) {
+        *last = parseExpr();
+
+        if (failed)
+            return printfStmt;
+
+        last = &(*last)->next;
+    }
+
+    if (expect(RIGHT_PARENTHESIS, "\")\""))
+        expect(SEMICOLON, "\";\"");
+
+    return printfStmt;
+}
+
+/**
+ * @brief Parses an assign or a call, which both start with a name; the
+ *        token after the name tells them apart
+ */
+Stmt* PredictiveParser::parseAssignOrCall() {
+    if (!check(LEFT_PARENTHESIS, 1))
+        return parseAssign();
+
+    CallStmt* callStmt = newNode<CallStmt>(SYNTAX_CALL_STMT,
+                                           tokens->offset(position));
+    callStmt->call = parseCall();
+    return callStmt;
+}
+
+/**
+ * @brief assign := name [ "[" expr "]" ] "=" expr
+ */
+AssignStmt* PredictiveParser::parseAssign() {
+    if (!checkName()) {
+        unexpected("the name of a variable");
+        return nullptr;
+    }
+
+    Token name = take();
+    AssignStmt* assign = newNode<AssignStmt>(SYNTAX_ASSIGN_STMT,
+                                             name.offset);
+    NameExpr* target = newNode<NameExpr>(SYNTAX_NAME_EXPR, name.offset);
+    target->name = name.character;
+    target->symbol = name.symbol;
+    assign->target = target;
+
+    if (accept(LEFT_BRACKET)) {
+        IndexExpr* element = newNode<IndexExpr>(SYNTAX_INDEX_EXPR,
+                                                name.offset);
+        element->array = target;
+        element->index = parseExpr();
+        assign->target = element;
+
+        if (!expect(RIGHT_BRACKET, "\"]\""))
+            return assign;
+    }
+
+    if (!expect(ASSIGNMENT, "\"=\""))
+        return assign;
+
+    assign->value = parseExpr();
+    return assign;
+}
+
+/**
+ * @brief expr := unary { operator unary }
+ */
+Expr* PredictiveParser::parseExpr() {
+    return parseBinary(parseUnary(), 1);
+}
+
+/**
+ * @brief Precedence climbing: joins left to the operators after it that
+ *        bind at least as tightly as minPrecedence
+ * @param left - The operand before the next operator
+ * @param minPrecedence - The loosest operator to join
+ * @remark ^ groups from the right and every other operator from the left
+ * @remark The lexer reads "a -1" as a name and the integer -1, so an integer
+ *         that starts with - right after an operand is a subtraction
+ */
+Expr* PredictiveParser::parseBinary(Expr* left, int minPrecedence) {
+    while (!atEnd()) {
+        TokenType type = tokens->type(position);
+        bool splitsInteger = type == INTEGER &&
+                             tokens->text(position)[0] == '-';
+        TokenType op = splitsInteger ? MINUS : type;
+        int precedence = getBinaryPrecedence(op);
+
+        if (precedence == 0 || precedence < minPrecedence)
+            break;
+
+        Expr* right;
+
+        if (splitsInteger) {
+            Token integer = take();
+            IntegerExpr* literal = newNode<IntegerExpr>(SYNTAX_INTEGER_EXPR,
+                                                        integer.offset + 1);
+            literal->text = integer.character.substr(1);
+            right = literal;
+        } else {
+            position++;
+            right = parseUnary();
+        }
+
+        right = parseBinary(right, op == CARAT ? precedence
+                                               : precedence + 1);
+
+        BinaryExpr* binary = newNode<BinaryExpr>(SYNTAX_BINARY_EXPR,
+                                                 left ? left->offset : 0);
+        binary->op = op;
+        binary->left = left;
+        binary->right = right;
+        left = binary;
+    }
+
+    return left;
+}
+
+/**
+ * @brief unary := ( "!" | "-" ) unary | primary
+ */
+Expr* PredictiveParser::parseUnary() {
+    NestingGuard guard(depth);
+
+    if (depth > MAX_NESTING_DEPTH) {
+        unexpected("fewer nested expressions");
+        return nullptr;
+    }
+
+    if (check(BOOLEAN_NOT_OPERATOR) || check(MINUS)) {
+        Token op = take();
+        UnaryExpr* unary = newNode<UnaryExpr>(SYNTAX_UNARY_EXPR, op.offset);
+        unary->op = op.type;
+        unary->operand = parseUnary();
+        return unary;
+    }
+
+    return parsePrimary();
+}
+
+/**
+ * @brief primary := integer | TRUE | FALSE | string | character | name
+ *                 | name "[" expr "]" | call | "(" expr ")"
+ */
+Expr* PredictiveParser::parsePrimary() {
+    if (atEnd()) {
+        unexpected("an expression");
+        return nullptr;
+    }
+
+    switch (tokens->type(position)) {
+        case INTEGER: {
+            Token integer = take();
+            IntegerExpr* literal = newNode<IntegerExpr>(SYNTAX_INTEGER_EXPR,
+                                                        integer.offset);
+            literal->text = integer.character;
+            return literal;
+        }
+
+        case BOOLEAN_TRUE:
+        case BOOLEAN_FALSE: {
+            Token boolean = take();
+            BoolExpr* literal = newNode<BoolExpr>(SYNTAX_BOOL_EXPR,
+                                                  boolean.offset);
+            literal->value = boolean.type == BOOLEAN_TRUE;
+            return literal;
+        }
+
+        case DOUBLE_QUOTE:
+        case SINGLE_QUOTE:
+            return parseString();
+
+        case IDENTIFIER:
+        case KEYWORD_STRING: {
+            if (check(LEFT_PARENTHESIS, 1))
+                return parseCall();
+
+            Token name = take();
+            NameExpr* variable = newNode<NameExpr>(SYNTAX_NAME_EXPR,
+                                                   name.offset);
+            variable->name = name.character;
+            variable->symbol = name.symbol;
+
+            if (!accept(LEFT_BRACKET))
+                return variable;
+
+            IndexExpr* element = newNode<IndexExpr>(SYNTAX_INDEX_EXPR,
+                                                    name.offset);
+            element->array = variable;
+            element->index = parseExpr();
+            expect(RIGHT_BRACKET, "\"]\"");
+            return element;
+        }
+
+        case LEFT_PARENTHESIS: {
+            position++;
+            Expr* inner = parseExpr();
+            expect(RIGHT_PARENTHESIS, "\")\"");
+            return inner;
+        }
+
+        default:
+            unexpected("an expression");
+            return nullptr;
+    }
+}
+
+/**
+ * @brief call := name "(" [ expr { "," expr } ] ")"
+ */
+CallExpr* PredictiveParser::parseCall() {
+    Token name = take();
+    CallExpr* call = newNode<CallExpr>(SYNTAX_CALL_EXPR, name.offset);
+    NameExpr* callee = newNode<NameExpr>(SYNTAX_NAME_EXPR, name.offset);
+    callee->name = name.character;
+    callee->symbol = name.symbol;
+    call->callee = callee;
+    // the ( was checked before the call
+    position++;
+
+    if (accept(RIGHT_PARENTHESIS))
+        return call;
+
+    Expr** last = &call->arguments;
+
+    do {
+        *last = parseExpr();
+
+        if (failed)
+            return call;
+
+        last = &(*last)->next;
+        call->argumentCount++;
+    } while (accept(COMMA));
+
+    expect(RIGHT_PARENTHESIS, "\")\"");
+    return call;
+}
+
+/**
+ * @brief Parses a string in double quotes or a character in single quotes;
+ *        the lexer gives the text between the quotes as one STRING token,
+ *        or none for empty quotes
+ */
+StringExpr* PredictiveParser::parseString() {
+    Token quote = take();
+    StringExpr* literal = newNode<StringExpr>(
+        quote.type == DOUBLE_QUOTE ? SYNTAX_STRING_EXPR : SYNTAX_CHAR_EXPR,
+        quote.offset);
+
+    if (check(STRING))
+        literal->text = take().character;
+
+    expect(quote.type, quote.type == DOUBLE_QUOTE ? "a closing \""
+                                                  : "a closing '");
+    return literal;
+}
+
+/**
+ * @brief Output operator overload
+ * @param os - The output stream operator
+ * @param obj - The PredictiveParser object to output
+ * @returns The modified output stream
+ */
+ostream& operator << (ostream& os, const PredictiveParser& obj) {
+    return printSyntaxTree(os, obj.program);
+}
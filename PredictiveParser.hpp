@@ -0,0 +1,226 @@
+/**
+ * @file PredictiveParser.hpp
+ * @brief Defines the PredictiveParser class, which parses a program by its
+ *        grammar into a tree of typed nodes
+ * @authors Jacob Franco, Zach Gassner, Haley Joerger, Adam Lyday
+ */
+
+#ifndef PREDICTIVE_PARSER_HPP
+#define PREDICTIVE_PARSER_HPP
+
+#include <iostream>
+#include "Arena.hpp"
+#include "Diagnostic.hpp"
+#include "SyntaxTree.hpp"
+#include "Tokenization.hpp"
+
+using namespace std;
+
+/**
+ * @brief Blocks, statements and parentheses nested deeper than this are
+ *        rejected, so that a hostile program cannot use up the stack
+ */
+const int MAX_NESTING_DEPTH = 1000;
+
+/**
+ * @class PredictiveParser
+ * @brief A recursive descent parser with one function for each rule of the
+ *        grammar, which picks the rule to use from the next token or two:
+ *
+ *      program     := { function | procedure | varDecl }
+ *      function    := "function" type name "(" params ")" block
+ *      procedure   := "procedure" name "(" params ")" block
+ *      params      := "void" | variable { "," variable }
+ *      varDecl     := type variable { "," variable } ";"
+ *      variable    := [ type ] name [ "[" integer "]" ]
+ *      name        := identifier | "string"
+ *      block       := "{" { statement } "}"
+ *      statement   := block | varDecl | if | for | while | return | printf
+ *                   | assign ";" | call ";"
+ *      if          := "if" "(" expr ")" statement [ "else" statement ]
+ *      for         := "for" "(" [ assign ] ";" [ expr ] ";" [ assign ] ")"
+ *                     statement
+ *      while       := "while" "(" expr ")" statement
+ *      return      := "return" [ expr ] ";"
+ *      printf      := "printf" "(" string { "," expr } ")" ";"
+ *      assign      := name [ "[" expr "]" ] "=" expr
+ *      call        := name "(" [ expr { "," expr } ] ")"
+ *      expr        := unary { operator unary }, by C precedence
+ *      unary       := ( "!" | "-" ) unary | primary
+ *      primary     := integer | TRUE | FALSE | string | character
+ *                   | name | name "[" expr "]" | call | "(" expr ")"
+ *
+ * @remark The nodes are made in an arena that the parser owns, so the tree
+ *         lives as long as the parser, and points into the program
+ * @remark Parsing stops at the first token the grammar does not allow, and
+ *         the error is kept in a Diagnostic
+ */
+class PredictiveParser {
+public:
+    /**
+     * @brief Constructor
+     * @param tokens - The tokens of a C-style program
+     */
+    PredictiveParser(const TokenStream& tokens);
+
+    /**
+     * @brief The parser owns the nodes of its tree, so it cannot be copied
+     */
+    PredictiveParser(const PredictiveParser&) = delete;
+    PredictiveParser& operator = (const PredictiveParser&) = delete;
+
+    /**
+     * @brief Getter for program private variable
+     * @returns The first top-level declaration, with the rest chained after
+     *          it; nullptr for an empty program or one that was rejected
+     */
+    const Stmt* getProgram() const;
+
+    /**
+     * @brief Returns true if the program does not follow the grammar
+     */
+    bool hasError() const;
+
+    /**
+     * @brief Getter for diagnostic private variable
+     * @returns The syntax error the program was rejected for
+     */
+    const Diagnostic& getDiagnostic() const;
+
+    /**
+     * @brief Output operator overload
+     * @param os - The output stream operator
+     * @param obj - The PredictiveParser object to output
+     * @returns The modified output stream
+     * @remark Outputs the tree one node per line; see printSyntaxTree
+     *
+     *      ex: cout << PredictiveParserObj;
+     */
+    friend ostream& operator << (ostream& os, const PredictiveParser& obj);
+
+private:
+    /**
+     * @brief Returns true once every token has been used
+     */
+    bool atEnd() const { return position >= tokens->size(); }
+
+    /**
+     * @brief Returns true if the token ahead tokens on from the next one has
+     *        the given type
+     */
+    bool check(TokenType type, size_t ahead = 0) const {
+        return position + ahead < tokens->size() &&
+               tokens->type(position + ahead) == type;
+    }
+
+    /**
+     * @brief Returns true if the token ahead tokens on from the next one can
+     *        be a name: an identifier, or "string", which the test programs
+     *        also use as the name of a variable
+     */
+    bool checkName(size_t ahead = 0) const {
+        return check(IDENTIFIER, ahead) || check(KEYWORD_STRING, ahead);
+    }
+
+    /**
+     * @brief Returns the next token and moves past it
+     */
+    Token take() { return (*tokens)[position++]; }
+
+    /**
+     * @brief Moves past the next token if it has the given type
+     * @returns True if it did
+     */
+    bool accept(TokenType type);
+
+    /**
+     * @brief Moves past the next token, which has to have the given type
+     * @param type - The type the grammar needs next
+     * @param expected - What the grammar needs, for the error message
+     * @returns False, after rejecting the program, if the token is not of
+     *          the type
+     */
+    bool expect(TokenType type, const char* expected);
+
+    /**
+     * @brief Rejects the program at the next token
+     * @param expected - What the grammar needs, for the error message
+     * @remark Moves to the end of the tokens, so every parse function
+     *         returns at once and the parse unwinds without checks at every
+     *         step. The nodes made until then are never looked at.
+     */
+    void unexpected(const char* expected);
+
+    /**
+     * @brief Makes a node in the arena
+     * @param kind - The node's kind
+     * @param offset - Where the node's first token starts in the program
+     * @remark Every other member of the node starts zeroed
+     */
+    template <typename T>
+    T* newNode(SyntaxKind kind, uint32_t offset) {
+        T* node = nodes.create<T>();
+        node->kind = kind;
+        node->offset = offset;
+        return node;
+    }
+
+    /**
+     * @brief Returns true if type is a type keyword a variable can have
+     */
+    static bool isType(TokenType type);
+
+    Stmt* parseDeclaration();
+    FunctionDecl* parseFunction();
+    Variable* parseParameters();
+    Variable* parseVariable(TokenType type);
+    VarDecl* parseVarDecl();
+    BlockStmt* parseBlock();
+    Stmt* parseStatement();
+    IfStmt* parseIf();
+    ForStmt* parseFor();
+    WhileStmt* parseWhile();
+    ReturnStmt* parseReturn();
+    PrintfStmt* parsePrintf();
+    Stmt* parseAssignOrCall();
+    AssignStmt* parseAssign();
+    Expr* parseExpr();
+    Expr* parseBinary(Expr* left, int minPrecedence);
+    Expr* parseUnary();
+    Expr* parsePrimary();
+    CallExpr* parseCall();
+    StringExpr* parseString();
+
+    /**
+     * @brief The tokens being parsed
+     */
+    const TokenStream* tokens;
+
+    /**
+     * @brief The index of the next token
+     */
+    size_t position;
+
+    /**
+     * @brief How deep the statement or expression being parsed is nested
+     */
+    int depth;
+
+    /**
+     * @brief Holds every node of the tree
+     */
+    Arena nodes;
+
+    /**
+     * @brief The first top-level declaration
+     */
+    Stmt* program;
+
+    /**
+     * @brief Set once the program is rejected, which is kept in diagnostic
+     */
+    bool failed;
+    Diagnostic diagnostic;
+};
+
+#endif
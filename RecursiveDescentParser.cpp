@@ -5,300 +5,258 @@
  */
 
 #include "RecursiveDescentParser.hpp"
-#include <queue>
+#include "TreeCursor.hpp"
+#include <sstream>
 
 /**
- * @param token - A token object
- * @returns The actual character(s) of the token
+ * @brief Breadth-first search function
+ * @returns A string with the resulting BFS
  */
-auto toTokenCharacter(Token token) {
-    return token.character;
+string LCRS::BFS() const {
+    ostringstream result;
+    printLevelOrder(result, LCRSCursor(this));
+    return result.str();
 }
 
 /**
- * @brief Returns string version of token type
- * @param token - A Token object
- * @returns A string of the token type instead of 0, 1, 2, ...
+ * @brief Returns the DFA state 
+ * @param type - The type of the token to get the DFA state for
  */
-auto toTokenType(Token token) {
-    switch (token.type) {
-        case CHAR:
-            return "CHAR";
-
-        case VOID:
-            return "VOID";
-
-        case IDENTIFIER:
-            return "IDENTIFIER";
-
-        case INTEGER:
-            return "INTEGER";
-
-        case STRING:
-            return "STRING";
-
-        case LEFT_PARENTHESIS:
-            return "LEFT_PARENTHESIS";
-
-        case RIGHT_PARENTHESIS:
-            return "RIGHT_PARENTHESIS";
-
-        case LEFT_BRACKET:
-            return "LEFT_BRACKET";
-
-        case RIGHT_BRACKET:
-            return "RIGHT_BRACKET";
-
-        case LEFT_BRACE:
-            return "LEFT_BRACE";
-
-        case RIGHT_BRACE:
-            return "RIGHT_BRACE";
-
-        case DOUBLE_QUOTE:
-            return "DOUBLE_QUOTE";
-
-        case SINGLE_QUOTE:
-            return "SINGLE_QUOTE";
-
-        case SEMICOLON:
-            return "SEMICOLON";
-
-        case COMMA:
-            return "COMMA";
-
-        case ASSIGNMENT:
-            return "ASSIGNMENT";
-
-        case PLUS:
-            return "PLUS";
-
-        case MINUS:
-            return "MINUS";
-
-        case DIVIDE:
-            return "DIVIDE";
-
-        case ASTERISK:
-            return "ASTERISK";
-
-        case MODULO:
-            return "MODULO";
-
-        case CARAT:
-            return "CARAT";
+State getStateDFA(TokenType type) {
+    switch (type) {
+        case KEYWORD_FUNCTION:
+        case KEYWORD_PROCEDURE:
+            return FUNCTION_DECLARATION;
 
-        case LT:
-            return "LT";
+        case KEYWORD_INT:
+        case KEYWORD_STRING:
+        case CHAR:
+        case KEYWORD_BOOL:
+            return VARIABLE_DECLARATION;
 
-        case GT:
-            return "GT";
+        case KEYWORD_IF:
+            return CONDITIONAL;
 
-        case LT_EQUAL:
-            return "LT_EQUAL";
+        case KEYWORD_FOR:
+        case KEYWORD_WHILE:
+            return LOOP;
 
-        case GT_EQUAL:
-            return "GT_EQUAL";
-    
-        case BOOLEAN_AND_OPERATOR:
-            return "BOOLEAN_AND_OPERATOR";
+        default:
+            return OTHER;
+    }
+}
 
-        case BOOLEAN_OR_OPERATOR:
-            return "BOOLEAN_OR_OPERATOR";
+/**
+ * @brief Constructor
+ * @remark Ready for the first token of a program
+ */
+StatementDFA::StatementDFA() 
+    : state(OTHER), leftParenCounter(0), previous(CHAR), started(false) { }
 
-        case BOOLEAN_NOT_OPERATOR:
-            return "BOOLEAN_NOT_OPERATOR";
+/**
+ * @brief Runs the DFA on the next token of the program
+ * @param type - The type of the token after the one given last time
+ * @returns True if the token starts a new statement, which it always does
+ *          for the first token
+ */
+bool StatementDFA::startsStatement(TokenType type) {
+    bool startsStatement = !started;
+
+    switch (state) {
+        case OTHER:
+            startsStatement |= previous == SEMICOLON || 
+                               previous == RIGHT_BRACE ||
+                               previous == LEFT_BRACE ||
+                               previous == KEYWORD_ELSE;
+            break;
+
+        case FUNCTION_DECLARATION:
+            startsStatement |= previous == RIGHT_PARENTHESIS;
+            break;
+
+        case VARIABLE_DECLARATION:
+        case VARIABLE_ASSIGNMENT:
+            startsStatement |= previous == SEMICOLON;
+            break;
+
+        case LOOP:
+        case CONDITIONAL:
+            if (previous == RIGHT_PARENTHESIS && leftParenCounter == 0) {
+                startsStatement = true;
+            } else if (!startsStatement) {
+                if (type == RIGHT_PARENTHESIS) 
+                    leftParenCounter--;
+
+                if (type == LEFT_PARENTHESIS) 
+                    leftParenCounter++;
+            }
+            break;
+    }
 
-        case BOOLEAN_EQUAL:
-            return "BOOLEAN_EQUAL";
+    if (startsStatement)
+        state = getStateDFA(type);
 
-        case BOOLEAN_NOT_EQUAL:
-            return "BOOLEAN_NOT_EQUAL";
+    previous = type;
+    started = true;
+    return startsStatement;
+}
 
-        case BOOLEAN_TRUE:
-            return "BOOLEAN_TRUE";
+/**
+ * @brief Returns true if both DFAs will decide the same for every token from
+ *        here on
+ */
+bool StatementDFA::operator == (const StatementDFA& other) const {
+    return state == other.state && 
+           leftParenCounter == other.leftParenCounter &&
+           previous == other.previous && started == other.started;
+}
 
-        case BOOLEAN_FALSE:
-            return "BOOLEAN_FALSE";
-        
-        default:
-            return "NONEXISTENT";
+/**
+ * @brief Constructor
+ * @param tokens - The tokens of a C-style program 
+ */
+RecursiveDescentParser::RecursiveDescentParser(const TokenStream& tokens) 
+    : RecursiveDescentParser(tokens.getLineIndex()) {
+    // the DFA reads only the type array; each Token is put together once,
+    // in the node that keeps it
+    for (size_t i = 0; i < tokens.size(); i++) {
+        bool startsStatement = dfa.startsStatement(tokens.type(i));
+        addNode(newNode(tokens[i]), startsStatement);
     }
 }
 
 /**
- * @brief Breadth-first search function
- * @returns A string with the resulting BFS
+ * @brief Constructor
+ * @param lineIndex - The line index for the offsets of the tokens that will
+ *                    be added
+ * @remark Starts with an empty CST; tokens are added with addToken
  */
-string LCRS::BFS() const {
-    /**
-     * @remark pair a LCRS node and its level in the tree 
-     */
-    queue<std::pair<const LCRS*, int>> q;
-    q.push({this, 0});
-    string result = "";
-    int currentLevel = -1;
-
-    while (!q.empty()) {
-        const LCRS* current = q.front().first;
-        int level = q.front().second;
-        q.pop();
-
-        if (level != currentLevel) {
-            if (currentLevel != -1) 
-                result += '\n';
-            
-            currentLevel = level;
-        }
-
-        result += toTokenCharacter(current->token) + ' ';
+RecursiveDescentParser::RecursiveDescentParser(const LineIndex& lineIndex) 
+    : concreteSyntaxTree(nullptr), current(nullptr), lineIndex(&lineIndex) { }
 
-        if (current->leftChild)
-            q.push({current->leftChild, level + 1});
-        if (current->rightSibling)
-            q.push({current->rightSibling, level});
+/**
+ * @brief Constructor
+ * @param lexer - A lexer that has not returned any tokens yet
+ * @remark Tokens are parsed as they are lexed, so the whole token vector 
+ *         never has to exist
+ */
+RecursiveDescentParser::RecursiveDescentParser(Lexer& lexer) 
+    : RecursiveDescentParser(lexer.getLineIndex()) {
+    parse(lexer);
+}
 
-    }
+/**
+ * @brief Constructor
+ * @param reader - A token cache that has not returned any tokens yet
+ * @remark Parses cached tokens, so the program is never lexed; the CST 
+ *         points into the cache
+ */
+RecursiveDescentParser::RecursiveDescentParser(TokenCacheReader& reader) 
+    : RecursiveDescentParser(reader.getLineIndex()) {
+    Token token;
 
-    return result += '\n';
+    while (reader.next(token))
+        addToken(token);
 }
 
 /**
- * @brief Returns the DFA state 
- * @param token - The token to get the DFA state for
+ * @brief Empties the CST so that another program can be parsed, keeping the
+ *        memory of its nodes
+ * @param lineIndex - The line index for the offsets of the tokens that will
+ *                    be added
  */
-State getStateDFA(Token token) {
-    if (token.type == IDENTIFIER) {
-        if (token.character == "function" || token.character == "procedure") 
-            return FUNCTION_DECLARATION;
-        
-        if (token.character == "int" || token.character == "string" ||
-            token.character == "char" || token.character == "bool")
-            return VARIABLE_DECLARATION;
-
-        if (token.character == "if")
-            return CONDITIONAL;
+void RecursiveDescentParser::reset(const LineIndex& lineIndex) {
+    nodes.reset();
+    concreteSyntaxTree = nullptr;
+    current = nullptr;
+    dfa = StatementDFA();
+    statements.clear();
+    this->lineIndex = &lineIndex;
+}
 
-        if (token.character == "for" || token.character == "while")
-            return LOOP;
+/**
+ * @brief Empties the CST, then parses every token the lexer returns
+ * @param lexer - A lexer that has not returned any tokens yet
+ */
+void RecursiveDescentParser::parse(Lexer& lexer) {
+    Token token;
+    bool restarted = false;
+    reset(lexer.getLineIndex());
+
+    while (lexer.next(token)) {
+        // the lexer started over on IgnoreComments' error message, so the 
+        // tokens parsed so far were not part of the program
+        if (lexer.hasRestarted() && !restarted) {
+            restarted = true;
+            reset(lexer.getLineIndex());
+        }
 
-        if (token.character == "=")
-            return VARIABLE_ASSIGNMENT;
+        addToken(token);
     }
-        
-    return OTHER;
 }
 
 /**
- * @brief Constructor
- * @param tokens - A vector of tokens from a C-style program 
+ * @brief Adds the next token of the program to the CST
+ * @param token - The token after the one in the current node
+ * @returns The token's node if the token starts a new statement, which 
+ *          means the statement before it is complete; otherwise nullptr
  */
-RecursiveDescentParser::RecursiveDescentParser(const vector<Token>& tokens) {
-    /**
-     * used to keep track of left parenthesis in the cases of math/bool expression 
-     */
-    int leftParenCounter = 0;
-
-    LCRS* lcrs = tokens.size() > 0 ? new LCRS(tokens[0]) : nullptr;
-    LCRS* temp = lcrs;
-    State state = getStateDFA(tokens[0]);
-
-    for (int i = 1; i < tokens.size(); i++) {
-        switch (state) {
-            case OTHER:
-                if (tokens[i - 1].type == SEMICOLON || 
-                    tokens[i - 1].type == RIGHT_BRACE ||
-                    tokens[i - 1].type == LEFT_BRACE ||
-                    tokens[i - 1].character == "else") {
-                    temp->leftChild = new LCRS(tokens[i]);
-                    temp = temp->leftChild;
-                    state = getStateDFA(tokens[i]);
-                } else {
-                    temp->rightSibling = new LCRS(tokens[i]);
-                    temp = temp->rightSibling;
-                }
-                break;
-
-            case FUNCTION_DECLARATION:
-                if (tokens[i - 1].type == RIGHT_PARENTHESIS) {
-                    temp->leftChild = new LCRS(tokens[i]);
-                    temp = temp->leftChild;
-                    state = getStateDFA(tokens[i]);
-                } else {
-                    temp->rightSibling = new LCRS(tokens[i]);
-                    temp = temp->rightSibling;
-                }
-                break;
-
-            case VARIABLE_DECLARATION:
-                if (tokens[i - 1].type == SEMICOLON) {
-                    temp->leftChild = new LCRS(tokens[i]);
-                    temp = temp->leftChild;
-                    state = getStateDFA(tokens[i]);
-                } else {
-                    temp->rightSibling = new LCRS(tokens[i]);
-                    temp = temp->rightSibling;
-                }
-                break;
-
-            case VARIABLE_ASSIGNMENT:
-                if (tokens[i - 1].type == SEMICOLON) {
-                    temp->leftChild = new LCRS(tokens[i]);
-                    temp = temp->leftChild;
-                    state = getStateDFA(tokens[i]);
-                } else {
-                    temp->rightSibling = new LCRS(tokens[i]);
-                    temp = temp->rightSibling;
-                }
-                break;
-
-            case LOOP:
-                if (tokens[i - 1].type == RIGHT_PARENTHESIS && leftParenCounter == 0) {
-                    temp->leftChild = new LCRS(tokens[i]);
-                    temp = temp->leftChild;
-                    state = getStateDFA(tokens[i]);
-                } else {
-                    if (tokens[i].type == RIGHT_PARENTHESIS) 
-                        leftParenCounter--;
-
-                    if (tokens[i].type == LEFT_PARENTHESIS) 
-                        leftParenCounter++;
-            
-                    temp->rightSibling = new LCRS(tokens[i]);
-                    temp = temp->rightSibling;
-                }
-                break;
-
-            case CONDITIONAL:
-                if (tokens[i - 1].type == RIGHT_PARENTHESIS && leftParenCounter == 0) {
-                    temp->leftChild = new LCRS(tokens[i]);
-                    temp = temp->leftChild;
-                    state = getStateDFA(tokens[i]);
-                } else {
-                    if (tokens[i].type == RIGHT_PARENTHESIS) 
-                        leftParenCounter--;
-
-                    if (tokens[i].type == LEFT_PARENTHESIS) 
-                        leftParenCounter++;
-            
-                    temp->rightSibling = new LCRS(tokens[i]);
-                    temp = temp->rightSibling;
-                }
-                break;
+LCRS* RecursiveDescentParser::addToken(const Token& token) {
+    bool startsStatement = dfa.startsStatement(token.type);
+    return addNode(newNode(token), startsStatement);
+}
 
-        }
-    }
+/**
+ * @brief Links a new node after the current one
+ * @param node - The node of the token after the one in the current node
+ * @param startsStatement - True if the DFA found that the node's token
+ *                          starts a new statement
+ * @returns node if its token starts a new statement; otherwise nullptr
+ */
+LCRS* RecursiveDescentParser::addNode(LCRS* node, bool startsStatement) {
+    if (current == nullptr)
+        concreteSyntaxTree = node;
+    else if (startsStatement)
+        current->leftChild = node;
+    else
+        current->rightSibling = node;
+
+    current = node;
+    statements.addToken(node->token.type, startsStatement, node);
+    return startsStatement ? node : nullptr;
+}
 
-    concreteSyntaxTree = lcrs;
+/**
+ * @brief Getter for statements private variable
+ * @returns Every statement of the CST, recorded as it was built
+ */
+const StatementTable<LCRSCursor>& RecursiveDescentParser::getStatements() const {
+    return statements;
 }
 
 /**
  * @brief Getter for CST 
  */
-LCRS* RecursiveDescentParser::getConcreteSyntaxTree() {
+LCRS* RecursiveDescentParser::getConcreteSyntaxTree() const {
     return concreteSyntaxTree;
 }
 
+/**
+ * @brief Getter for lineIndex private variable
+ * @returns The line index for the offsets of the tokens in the CST
+ */
+const LineIndex& RecursiveDescentParser::getLineIndex() const {
+    return *lineIndex;
+}
+
+/**
+ * @brief Returns the line number of a token in the CST, for diagnostics
+ * @param token - A token from the CST
+ */
+int RecursiveDescentParser::getLineNumber(const Token& token) const {
+    return lineIndex->getLineNumber(token.offset);
+}
+
 /**
  * @brief Output operator overload
  * @param os - The output stream operator
@@ -309,6 +267,5 @@ LCRS* RecursiveDescentParser::getConcreteSyntaxTree() {
  *      ex: cout << RecursiveDescentParserObj;
  */
 ostream& operator << (ostream& os, const RecursiveDescentParser& obj) {
-    os << obj.concreteSyntaxTree->BFS();
-    return os;
+    return printLevelOrder(os, LCRSCursor(obj.concreteSyntaxTree));
 }
\ No newline at end of file
@@ -11,6 +11,9 @@
 
 #include "IgnoreComments.hpp"
 #include "Tokenization.hpp"
+#include "TokenCache.hpp"
+#include "Arena.hpp"
+#include "StatementTable.hpp"
 #include <iostream>
 #include <vector>
 
@@ -63,18 +66,92 @@ private:
      */
     LCRS* rightSibling;
 
-    /**
-     * @brief Returns the DFA state 
-     * @param token - The token to get the DFA state for
-     */
-    State getStateDFA(Token token);
-
     /**
      * @brief So RecursiveDescentParser can access LCRS private variables 
      */
     friend class RecursiveDescentParser;
     friend class AbstractSyntaxTree;
     friend class SymbolTable;
+    friend class LCRSCursor;
+};
+
+/**
+ * @class LCRSCursor
+ * @brief Walks a tree of LCRS nodes; see TreeCursor.hpp
+ */
+class LCRSCursor {
+public:
+    /**
+     * @brief Constructor
+     * @param node - The node to point at, or nullptr for no node
+     */
+    LCRSCursor(const LCRS* node = nullptr) : node(node) { }
+
+    explicit operator bool () const { return node != nullptr; }
+    const Token& token() const { return node->token; }
+    LCRSCursor leftChild() const { return node->leftChild; }
+    LCRSCursor rightSibling() const { return node->rightSibling; }
+
+private:
+    /**
+     * @brief The node pointed at
+     */
+    const LCRS* node;
+};
+
+/**
+ * @class StatementDFA
+ * @brief Decides where each token goes in the CST: as the right sibling of 
+ *        the token before it, or as its left child, which starts a new
+ *        statement
+ * @remark Builds no nodes, so every tree representation is built with the 
+ *         same DFA and comes out the same shape
+ */
+class StatementDFA {
+public:
+    /**
+     * @brief Constructor
+     * @remark Ready for the first token of a program
+     */
+    StatementDFA();
+
+    /**
+     * @brief Runs the DFA on the next token of the program
+     * @param type - The type of the token after the one given last time
+     * @returns True if the token starts a new statement, which it always 
+     *          does for the first token
+     * @remark Only token types decide statements, so a TokenStream can be
+     *         run through the DFA without putting its Tokens together
+     */
+    bool startsStatement(TokenType type);
+
+    /**
+     * @brief Returns true if both DFAs will decide the same for every token
+     *        from here on
+     */
+    bool operator == (const StatementDFA& other) const;
+
+private:
+    /**
+     * @brief The DFA state of the statement being added to the CST
+     */
+    State state;
+
+    /**
+     * @brief Used to keep track of left parenthesis in the cases of 
+     *        math/bool expression 
+     */
+    int leftParenCounter;
+
+    /**
+     * @brief The type of the token given last time
+     */
+    TokenType previous;
+
+    /**
+     * @brief True once a token has been given
+     */
+    bool started;
 };
 
 
@@ -86,14 +163,85 @@ class RecursiveDescentParser {
 public:
     /**
      * @brief Constructor
-     * @param tokens - A vector of tokens from a C-style program 
+     * @param tokens - The tokens of a C-style program 
      */
-    RecursiveDescentParser(const vector<Token>& tokens);
+    RecursiveDescentParser(const TokenStream& tokens);
+
+    /**
+     * @brief Constructor
+     * @param lexer - A lexer that has not returned any tokens yet
+     * @remark Tokens are parsed as they are lexed, so the whole token vector 
+     *         never has to exist
+     */
+    RecursiveDescentParser(Lexer& lexer);
+
+    /**
+     * @brief Constructor
+     * @param reader - A token cache that has not returned any tokens yet
+     * @remark Parses cached tokens, so the program is never lexed; the CST
+     *         points into the cache
+     */
+    RecursiveDescentParser(TokenCacheReader& reader);
+
+    /**
+     * @brief Constructor
+     * @param lineIndex - The line index for the offsets of the tokens that
+     *                    will be added
+     * @remark Starts with an empty CST; tokens are added with addToken
+     */
+    RecursiveDescentParser(const LineIndex& lineIndex);
+
+    /**
+     * @brief The parser owns the nodes of its CST, so it cannot be copied
+     */
+    RecursiveDescentParser(const RecursiveDescentParser&) = delete;
+    RecursiveDescentParser& operator = (const RecursiveDescentParser&) = delete;
+
+    /**
+     * @brief Empties the CST so that another program can be parsed, keeping
+     *        the memory of its nodes
+     * @param lineIndex - The line index for the offsets of the tokens that
+     *                    will be added
+     * @remark Nodes of the old CST must not be used after this
+     */
+    void reset(const LineIndex& lineIndex);
+
+    /**
+     * @brief Empties the CST, then parses every token the lexer returns
+     * @param lexer - A lexer that has not returned any tokens yet
+     */
+    void parse(Lexer& lexer);
+
+    /**
+     * @brief Adds the next token of the program to the CST
+     * @param token - The token after the one in the current node
+     * @returns The token's node if the token starts a new statement, which 
+     *          means the statement before it is complete; otherwise nullptr
+     */
+    LCRS* addToken(const Token& token);
 
     /**
      * @brief Getter for CST 
      */
-    LCRS* getConcreteSyntaxTree();
+    LCRS* getConcreteSyntaxTree() const;
+
+    /**
+     * @brief Getter for statements private variable
+     * @returns Every statement of the CST, recorded as it was built
+     */
+    const StatementTable<LCRSCursor>& getStatements() const;
+
+    /**
+     * @brief Getter for lineIndex private variable
+     * @returns The line index for the offsets of the tokens in the CST
+     */
+    const LineIndex& getLineIndex() const;
+
+    /**
+     * @brief Returns the line number of a token in the CST, for diagnostics
+     * @param token - A token from the CST
+     */
+    int getLineNumber(const Token& token) const;
 
     /**
      * @brief Output operator overload
@@ -107,10 +255,52 @@ public:
     friend ostream& operator << (ostream& os, const RecursiveDescentParser& obj);
 
 private:
+    /**
+     * @brief Returns a new node holding token
+     * @param token - The token for the node
+     */
+    LCRS* newNode(const Token& token) { return nodes.create<LCRS>(token); }
+
+    /**
+     * @brief Links a new node after the current one
+     * @param node - The node of the token after the one in the current node
+     * @param startsStatement - True if the DFA found that the node's token
+     *                          starts a new statement
+     * @returns node if its token starts a new statement; otherwise nullptr
+     */
+    LCRS* addNode(LCRS* node, bool startsStatement);
+
+    /**
+     * @brief Holds every node of the CST, which are all freed together when
+     *        the parser dies; reset rewinds it so the next CST reuses the
+     *        same memory
+     */
+    Arena nodes;
+
     /**
      * @brief The CST 
      */
     LCRS* concreteSyntaxTree;
+
+    /**
+     * @brief The node holding the last token added to the CST
+     */
+    LCRS* current;
+
+    /**
+     * @brief Decides where each token goes
+     */
+    StatementDFA dfa;
+
+    /**
+     * @brief Every statement of the CST
+     */
+    StatementTable<LCRSCursor> statements;
+
+    /**
+     * @brief The line index of the tokenized program, owned by Tokenization
+     */
+    const LineIndex* lineIndex;
 };
 
 #endif
\ No newline at end of file
@@ -0,0 +1,47 @@
+/**
+ * @file Session.cpp
+ * @brief Implementation file for the Session class
+ * @authors Jacob Franco, Zach Gassner, Haley Joerger, Adam Lyday
+ */
+
+#include "Session.hpp"
+#include "abstractsyntaxtree.hpp"
+
+/**
+ * @brief Constructor
+ * @remark Starts with nothing allocated
+ */
+Session::Session() 
+    : parser(lexer.getLineIndex()), symbolTable(lexer.getLineIndex()) { }
+
+/**
+ * @brief Runs every stage on one program and prints the AST
+ * @param source - A C-style program that may still contain comments
+ * @param diagnostic - Receives the error the program was rejected for
+ * @returns False if a stage rejected the program, in which case nothing is
+ *          printed
+ */
+bool Session::analyze(const SourceBuffer& source, Diagnostic& diagnostic) {
+    // comments are skipped while tokenizing, so the program is read once and
+    // never copied; the parser pulls tokens from the lexer as it needs them,
+    // so no token vector is built, and each later stage borrows the previous
+    // stage's output by const reference
+    lexer.reset(source);
+    parser.parse(lexer);
+
+    // a lexer error ends the tokens early, so the CST is not the program's
+    if (lexer.hasError()) {
+        diagnostic = lexer.getDiagnostic();
+        return false;
+    }
+
+    symbolTable.reset(parser);
+
+    if (symbolTable.hasError()) {
+        diagnostic = symbolTable.getDiagnostic();
+        return false;
+    }
+
+    AbstractSyntaxTree abstractSyntaxTree(parser, symbolTable);
+    return true;
+}
@@ -0,0 +1,63 @@
+/**
+ * @file Session.hpp
+ * @brief Defines the Session class that analyzes one program after another 
+ *        with the same stages
+ * @authors Jacob Franco, Zach Gassner, Haley Joerger, Adam Lyday
+ */
+
+#ifndef SESSION_HPP
+#define SESSION_HPP
+
+#include "SourceBuffer.hpp"
+#include "Diagnostic.hpp"
+#include "Tokenization.hpp"
+#include "RecursiveDescentParser.hpp"
+#include "symboltable.hpp"
+
+using namespace std;
+
+/**
+ * @class Session
+ * @brief Keeps the lexer, parser and symbol table alive between programs, so
+ *        that each program reuses the memory the ones before it needed
+ * @remark Once a session has seen a program as big as the next one, lexing,
+ *         parsing and building the symbol table for it allocate next to 
+ *         nothing: pending tokens, line starts, CST nodes and table entries
+ *         are all reset instead of freed
+ */
+class Session {
+public:
+    /**
+     * @brief Constructor
+     * @remark Starts with nothing allocated
+     */
+    Session();
+
+    /**
+     * @brief Runs every stage on one program and prints the AST
+     * @param source - A C-style program that may still contain comments
+     * @param diagnostic - Receives the error the program was rejected for
+     * @returns False if a stage rejected the program, in which case nothing
+     *          is printed
+     * @remark Whatever the session held for the program before is reset
+     */
+    bool analyze(const SourceBuffer& source, Diagnostic& diagnostic);
+
+private:
+    /**
+     * @brief Produces the tokens of the current program
+     */
+    Lexer lexer;
+
+    /**
+     * @brief Builds the CST of the current program
+     */
+    RecursiveDescentParser parser;
+
+    /**
+     * @brief Built from the CST of the current program
+     */
+    SymbolTable symbolTable;
+};
+
+#endif
@@ -0,0 +1,265 @@
+/**
+ * @file SimdScan.cpp
+ * @brief Implementation file for the vectorized character scans
+ * @authors Jacob Franco, Zach Gassner, Haley Joerger, Adam Lyday
+ */
+
+#include "SimdScan.hpp"
+#include <cstring>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#define SIMD_SCAN_X86 1
+#endif
+
+namespace {
+
+using MatchBlockScan = void (*)(const char*, const char*, int, uint64_t*);
+using AsciiBlockScan = bool (*)(const char*);
+
+/**
+ * @brief Scalar version of matchBlock, also used for short blocks
+ */
+void matchBlockScalar(const char* block, size_t count, const char* needles,
+                      int needleCount, uint64_t* masks) {
+    for (int k = 0; k < needleCount; k++)
+        masks[k] = 0;
+
+    for (size_t i = 0; i < count; i++) {
+        for (int k = 0; k < needleCount; k++) {
+            if (block[i] == needles[k])
+                masks[k] |= uint64_t(1) << i;
+        }
+    }
+}
+
+/**
+ * @brief matchBlock over a full block without vector instructions
+ */
+void matchFullBlockScalar(const char* block, const char* needles,
+                          int needleCount, uint64_t* masks) {
+    matchBlockScalar(block, SCAN_BLOCK_SIZE, needles, needleCount, masks);
+}
+
+/**
+ * @brief Returns true if a full block is all ASCII, 8 characters at a time
+ */
+bool isAsciiBlockScalar(const char* block) {
+    uint64_t bits = 0;
+
+    for (size_t i = 0; i < SCAN_BLOCK_SIZE; i += 8) {
+        uint64_t word;
+        memcpy(&word, block + i, 8);
+        bits |= word;
+    }
+
+    return (bits & 0x8080808080808080ULL) == 0;
+}
+
+#ifdef SIMD_SCAN_X86
+/**
+ * @brief matchBlock over a full block, 16 characters at a time
+ */
+__attribute__((target("sse2")))
+void matchFullBlockSse2(const char* block, const char* needles,
+                        int needleCount, uint64_t* masks) {
+    const __m128i* in = reinterpret_cast<const __m128i*>(block);
+    __m128i chunk0 = _mm_loadu_si128(in);
+    __m128i chunk1 = _mm_loadu_si128(in + 1);
+    __m128i chunk2 = _mm_loadu_si128(in + 2);
+    __m128i chunk3 = _mm_loadu_si128(in + 3);
+
+    for (int k = 0; k < needleCount; k++) {
+        __m128i needle = _mm_set1_epi8(needles[k]);
+        uint64_t bits0 = uint16_t(_mm_movemask_epi8(_mm_cmpeq_epi8(chunk0, needle)));
+        uint64_t bits1 = uint16_t(_mm_movemask_epi8(_mm_cmpeq_epi8(chunk1, needle)));
+        uint64_t bits2 = uint16_t(_mm_movemask_epi8(_mm_cmpeq_epi8(chunk2, needle)));
+        uint64_t bits3 = uint16_t(_mm_movemask_epi8(_mm_cmpeq_epi8(chunk3, needle)));
+        masks[k] = bits0 | bits1 << 16 | bits2 << 32 | bits3 << 48;
+    }
+}
+
+/**
+ * @brief matchBlock over a full block, 32 characters at a time
+ */
+__attribute__((target("avx2")))
+void matchFullBlockAvx2(const char* block, const char* needles,
+                        int needleCount, uint64_t* masks) {
+    const __m256i* in = reinterpret_cast<const __m256i*>(block);
+    __m256i low = _mm256_loadu_si256(in);
+    __m256i high = _mm256_loadu_si256(in + 1);
+
+    for (int k = 0; k < needleCount; k++) {
+        __m256i needle = _mm256_set1_epi8(needles[k]);
+        uint64_t lowBits = uint32_t(_mm256_movemask_epi8(_mm256_cmpeq_epi8(low, needle)));
+        uint64_t highBits = uint32_t(_mm256_movemask_epi8(_mm256_cmpeq_epi8(high, needle)));
+        masks[k] = lowBits | highBits << 32;
+    }
+}
+
+/**
+ * @brief Returns true if a full block is all ASCII, 16 characters at a time
+ */
+__attribute__((target("sse2")))
+bool isAsciiBlockSse2(const char* block) {
+    const __m128i* in = reinterpret_cast<const __m128i*>(block);
+    __m128i bits = _mm_or_si128(
+        _mm_or_si128(_mm_loadu_si128(in), _mm_loadu_si128(in + 1)),
+        _mm_or_si128(_mm_loadu_si128(in + 2), _mm_loadu_si128(in + 3)));
+    return _mm_movemask_epi8(bits) == 0;
+}
+
+/**
+ * @brief Returns true if a full block is all ASCII, 32 characters at a time
+ */
+__attribute__((target("avx2")))
+bool isAsciiBlockAvx2(const char* block) {
+    const __m256i* in = reinterpret_cast<const __m256i*>(block);
+    __m256i bits = _mm256_or_si256(_mm256_loadu_si256(in),
+                                   _mm256_loadu_si256(in + 1));
+    return _mm256_movemask_epi8(bits) == 0;
+}
+#endif
+
+#ifdef SIMD_SCAN_X86
+/**
+ * @brief Picks the widest version of a scan this CPU can run
+ * @param scalar - The version without vector instructions
+ * @param sse2 - The version that needs SSE2
+ * @param avx2 - The version that needs AVX2
+ * @returns The AVX2 version if supported, else the SSE2 version if
+ *          supported, else the scalar version
+ */
+template <typename Scan>
+Scan chooseScan(Scan scalar, Scan sse2, Scan avx2) {
+    __builtin_cpu_init();
+
+    if (__builtin_cpu_supports("avx2"))
+        return avx2;
+
+    if (__builtin_cpu_supports("sse2"))
+        return sse2;
+
+    return scalar;
+}
+
+/**
+ * @brief The matcher used for every full block, chosen at startup
+ */
+const MatchBlockScan matchFullBlock = chooseScan(
+    matchFullBlockScalar, matchFullBlockSse2, matchFullBlockAvx2);
+
+/**
+ * @brief The ASCII check used for every full block, chosen at startup
+ */
+const AsciiBlockScan isAsciiBlock = chooseScan(
+    isAsciiBlockScalar, isAsciiBlockSse2, isAsciiBlockAvx2);
+#else
+const MatchBlockScan matchFullBlock = matchFullBlockScalar;
+const AsciiBlockScan isAsciiBlock = isAsciiBlockScalar;
+#endif
+
+/**
+ * @brief Decodes one multi-byte UTF-8 sequence
+ * @param bytes - The lead byte of the sequence, which is not ASCII
+ * @param available - The number of bytes left in the input
+ * @returns The length of the sequence, or 0 if it is invalid
+ */
+size_t utf8SequenceLength(const unsigned char* bytes, size_t available) {
+    unsigned char lead = bytes[0];
+    size_t length;
+    // the allowed range of the second byte, which is where overlong forms,
+    // surrogates and code points past U+10FFFF show up
+    unsigned char low = 0x80;
+    unsigned char high = 0xBF;
+
+    if (lead < 0xC2) {
+        return 0;
+    } else if (lead < 0xE0) {
+        length = 2;
+    } else if (lead < 0xF0) {
+        length = 3;
+
+        if (lead == 0xE0)
+            low = 0xA0;
+        else if (lead == 0xED)
+            high = 0x9F;
+    } else if (lead < 0xF5) {
+        length = 4;
+
+        if (lead == 0xF0)
+            low = 0x90;
+        else if (lead == 0xF4)
+            high = 0x8F;
+    } else {
+        return 0;
+    }
+
+    if (available < length || bytes[1] < low || bytes[1] > high)
+        return 0;
+
+    for (size_t i = 2; i < length; i++) {
+        if ((bytes[i] & 0xC0) != 0x80)
+            return 0;
+    }
+
+    return length;
+}
+
+} // namespace
+
+/**
+ * @brief Finds where each of a few characters appears in a block of input
+ * @param block - The first character of the block
+ * @param count - The number of characters in the block, at most 64
+ * @param needles - The characters to look for
+ * @param needleCount - The number of characters in needles
+ * @param masks - Output, one per needle; bit i of masks[k] is set when
+ *                block[i] == needles[k]
+ */
+void matchBlock(const char* block, size_t count, const char* needles,
+                int needleCount, uint64_t* masks) {
+    if (count == SCAN_BLOCK_SIZE)
+        matchFullBlock(block, needles, needleCount, masks);
+    else
+        matchBlockScalar(block, count, needles, needleCount, masks);
+}
+
+/**
+ * @brief Finds the first byte that is not part of valid UTF-8
+ * @param data - The first character to check
+ * @param size - The number of characters to check
+ * @returns The offset of the first byte of the first invalid sequence, or 
+ *          size if everything is valid UTF-8
+ */
+size_t findInvalidUtf8(const char* data, size_t size) {
+    const unsigned char* bytes = reinterpret_cast<const unsigned char*>(data);
+    size_t i = 0;
+
+    while (i < size) {
+        if (i + SCAN_BLOCK_SIZE <= size && isAsciiBlock(data + i)) {
+            i += SCAN_BLOCK_SIZE;
+            continue;
+        }
+
+        // decode to the end of this block; a sequence that crosses into the
+        // next block is finished first
+        size_t end = i + SCAN_BLOCK_SIZE < size ? i + SCAN_BLOCK_SIZE : size;
+
+        while (i < end) {
+            if (bytes[i] < 0x80) {
+                i++;
+                continue;
+            }
+
+            size_t length = utf8SequenceLength(bytes + i, size - i);
+
+            if (length == 0)
+                return i;
+
+            i += length;
+        }
+    }
+
+    return size;
+}
@@ -0,0 +1,45 @@
+/**
+ * @file SimdScan.hpp
+ * @brief Declares vectorized character scans used by the front end
+ * @authors Jacob Franco, Zach Gassner, Haley Joerger, Adam Lyday
+ */
+
+#ifndef SIMD_SCAN_HPP
+#define SIMD_SCAN_HPP
+
+#include <cstddef>
+#include <cstdint>
+
+/**
+ * @brief The number of characters matchBlock looks at in one call
+ */
+const size_t SCAN_BLOCK_SIZE = 64;
+
+/**
+ * @brief Finds where each of a few characters appears in a block of input
+ * @param block - The first character of the block
+ * @param count - The number of characters in the block, at most 64
+ * @param needles - The characters to look for
+ * @param needleCount - The number of characters in needles
+ * @param masks - Output, one per needle; bit i of masks[k] is set when
+ *                block[i] == needles[k]
+ * @remark Uses AVX2 or SSE2 when the CPU has them (checked once at runtime)
+ *         and a plain loop everywhere else. Short blocks always use the loop.
+ */
+void matchBlock(const char* block, size_t count, const char* needles,
+                int needleCount, uint64_t* masks);
+
+/**
+ * @brief Finds the first byte that is not part of valid UTF-8
+ * @param data - The first character to check
+ * @param size - The number of characters to check
+ * @returns The offset of the first byte of the first invalid sequence, or 
+ *          size if everything is valid UTF-8
+ * @remark Overlong encodings, surrogates, code points past U+10FFFF and
+ *         sequences cut off by the end are invalid. Blocks of plain ASCII,
+ *         which is nearly all of a program, are skipped 64 bytes at a time
+ *         with vector instructions; only blocks with other bytes are decoded.
+ */
+size_t findInvalidUtf8(const char* data, size_t size);
+
+#endif
@@ -0,0 +1,475 @@
+/**
+ * @file SourceBatch.cpp
+ * @brief Implementation file for the SourceBatch class
+ * @authors Jacob Franco, Zach Gassner, Haley Joerger, Adam Lyday
+ */
+
+#include "SourceBatch.hpp"
+#include <linux/io_uring.h>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#include <cerrno>
+#include <climits>
+#include <cstring>
+
+/**
+ * @brief Number of submission queue entries; every file in a window needs
+ *        two at a time
+ */
+static const unsigned URING_ENTRIES = 2 * BATCH_WINDOW_SIZE;
+
+/**
+ * @brief The result of an entry whose completion never arrived
+ */
+static const int URING_NO_RESULT = INT_MIN;
+
+/**
+ * @class Uring
+ * @brief The submission and completion rings of one io_uring instance
+ * @remark Talks to the kernel directly, so there is no dependency on
+ *         liburing
+ */
+class Uring {
+public:
+    /**
+     * @brief Constructor
+     * @remark Check isOpen() afterwards; io_uring may be missing or disabled
+     */
+    Uring() : fd(-1), sqRing(MAP_FAILED), cqRing(MAP_FAILED),
+              sqes(static_cast<io_uring_sqe*>(MAP_FAILED)), pending(0) {
+        io_uring_params params;
+        memset(&params, 0, sizeof(params));
+        fd = syscall(__NR_io_uring_setup, URING_ENTRIES, &params);
+
+        if (fd < 0)
+            return;
+
+        sqRingSize = params.sq_off.array + params.sq_entries * sizeof(unsigned);
+        cqRingSize = params.cq_off.cqes +
+                     params.cq_entries * sizeof(io_uring_cqe);
+        sqesSize = params.sq_entries * sizeof(io_uring_sqe);
+
+        if (params.features & IORING_FEAT_SINGLE_MMAP)
+            sqRingSize = cqRingSize = max(sqRingSize, cqRingSize);
+
+        sqRing = mmap(nullptr, sqRingSize, PROT_READ | PROT_WRITE,
+                      MAP_SHARED | MAP_POPULATE, fd, IORING_OFF_SQ_RING);
+        cqRing = (params.features & IORING_FEAT_SINGLE_MMAP) ? sqRing :
+                 mmap(nullptr, cqRingSize, PROT_READ | PROT_WRITE,
+                      MAP_SHARED | MAP_POPULATE, fd, IORING_OFF_CQ_RING);
+        sqes = static_cast<io_uring_sqe*>(
+                   mmap(nullptr, sqesSize, PROT_READ | PROT_WRITE,
+                        MAP_SHARED | MAP_POPULATE, fd, IORING_OFF_SQES));
+
+        if (sqRing == MAP_FAILED || cqRing == MAP_FAILED ||
+            sqes == MAP_FAILED) {
+            release();
+            return;
+        }
+
+        char* sq = static_cast<char*>(sqRing);
+        char* cq = static_cast<char*>(cqRing);
+        sqTail = reinterpret_cast<unsigned*>(sq + params.sq_off.tail);
+        sqMask = *reinterpret_cast<unsigned*>(sq + params.sq_off.ring_mask);
+        sqArray = reinterpret_cast<unsigned*>(sq + params.sq_off.array);
+        cqHead = reinterpret_cast<unsigned*>(cq + params.cq_off.head);
+        cqTail = reinterpret_cast<unsigned*>(cq + params.cq_off.tail);
+        cqMask = *reinterpret_cast<unsigned*>(cq + params.cq_off.ring_mask);
+        cqes = reinterpret_cast<io_uring_cqe*>(cq + params.cq_off.cqes);
+    }
+
+    /**
+     * @brief Destructor
+     */
+    ~Uring() {
+        release();
+    }
+
+    /**
+     * @brief Getter for whether io_uring could be set up
+     */
+    bool isOpen() const { return fd >= 0; }
+
+    /**
+     * @brief Returns a cleared submission queue entry to fill in
+     * @remark At most URING_ENTRIES entries may be added before submit()
+     */
+    io_uring_sqe* add() {
+        unsigned tail = *sqTail + pending;
+        unsigned index = tail & sqMask;
+        sqArray[index] = index;
+        pending++;
+        memset(&sqes[index], 0, sizeof(io_uring_sqe));
+        return &sqes[index];
+    }
+
+    /**
+     * @brief Submits the added entries and waits for all their completions
+     * @param results - Receives each completion's result at the index given
+     *                  by its user_data
+     * @returns False if the kernel refused the submission
+     */
+    bool submit(vector<int>& results) {
+        unsigned expected = pending;
+        __atomic_store_n(sqTail, *sqTail + pending, __ATOMIC_RELEASE);
+
+        while (expected > 0) {
+            int count = syscall(__NR_io_uring_enter, fd, pending, 1,
+                                IORING_ENTER_GETEVENTS, nullptr, 0);
+
+            if (count < 0) {
+                if (errno == EINTR)
+                    continue;
+
+                return false;
+            }
+
+            pending -= count;
+            unsigned head = *cqHead;
+
+            while (head != __atomic_load_n(cqTail, __ATOMIC_ACQUIRE)) {
+                const io_uring_cqe& completion = cqes[head & cqMask];
+                results[completion.user_data] = completion.res;
+                head++;
+                expected--;
+            }
+
+            __atomic_store_n(cqHead, head, __ATOMIC_RELEASE);
+        }
+
+        return true;
+    }
+
+private:
+    /**
+     * @brief Unmaps the rings and closes the ring's file descriptor
+     */
+    void release() {
+        if (sqes != MAP_FAILED)
+            munmap(sqes, sqesSize);
+        if (cqRing != MAP_FAILED && cqRing != sqRing)
+            munmap(cqRing, cqRingSize);
+        if (sqRing != MAP_FAILED)
+            munmap(sqRing, sqRingSize);
+        if (fd >= 0)
+            close(fd);
+
+        fd = -1;
+        sqRing = cqRing = MAP_FAILED;
+        sqes = static_cast<io_uring_sqe*>(MAP_FAILED);
+    }
+
+    int fd;
+    void* sqRing;
+    void* cqRing;
+    io_uring_sqe* sqes;
+    size_t sqRingSize;
+    size_t cqRingSize;
+    size_t sqesSize;
+    unsigned* sqTail;
+    unsigned sqMask;
+    unsigned* sqArray;
+    unsigned* cqHead;
+    unsigned* cqTail;
+    unsigned cqMask;
+    io_uring_cqe* cqes;
+
+    /**
+     * @brief Entries added since the last submit that the kernel has not
+     *        taken yet
+     */
+    unsigned pending;
+};
+
+/**
+ * @brief Constructor
+ * @param fileNames - The names of files that contain C-style programs
+ * @remark Returns right away; the files are loaded in the background
+ */
+SourceBatch::SourceBatch(const vector<string>& fileNames)
+    : fileNames(fileNames), sources(fileNames.size()), nextFile(0), taken(0),
+      stopping(false) {
+    loader = thread([this] {
+        if (loadWithUring())
+            return;
+
+        // io_uring is not available, so spread the files over a pool
+        unsigned poolSize = max(1u, min(8u, thread::hardware_concurrency()));
+
+        for (unsigned i = 1; i < poolSize; i++)
+            pool.emplace_back(&SourceBatch::loadWithPread, this);
+
+        loadWithPread();
+    });
+}
+
+/**
+ * @brief Destructor
+ * @remark Stops the background loading, waiting only for the files being 
+ *         loaded right now
+ */
+SourceBatch::~SourceBatch() {
+    {
+        lock_guard<mutex> guard(lock);
+        stopping = true;
+    }
+
+    room.notify_all();
+
+    // the pool is started by loader, so it is complete once loader is done
+    loader.join();
+
+    for (thread& worker : pool)
+        worker.join();
+}
+
+/**
+ * @brief Hands over a loaded file, waiting for it if it is not loaded yet
+ * @param i - The index of the file in the list given to the constructor
+ */
+unique_ptr<SourceBuffer> SourceBatch::take(size_t i) {
+    unique_lock<mutex> guard(lock);
+
+    // asking for a file lets the loading run further ahead, up to and 
+    // including the file itself
+    if (i >= taken) {
+        taken = i + 1;
+        room.notify_all();
+    }
+
+    loaded.wait(guard, [&] { return sources[i] != nullptr; });
+    return move(sources[i]);
+}
+
+/**
+ * @brief Waits until file i is close enough to the files taken to load
+ * @returns False if the batch is being destroyed instead
+ */
+bool SourceBatch::waitForRoom(size_t i) {
+    unique_lock<mutex> guard(lock);
+    room.wait(guard, [&] { 
+        return stopping || i < taken + BATCH_WINDOWS_AHEAD * BATCH_WINDOW_SIZE;
+    });
+    return !stopping;
+}
+
+/**
+ * @brief Loads every file through io_uring
+ * @returns False if io_uring could not be set up or stopped working, in
+ *          which case nextFile is the first file that still needs loading
+ * @remark Each window of files takes three submissions: one that opens 
+ *         every file, one that stats the opened files and one that reads 
+ *         and closes them. Anything unusual about a file (an error, not a 
+ *         regular file, too big, a short read) is left to SourceBuffer, 
+ *         which handles it the same as for a single file.
+ */
+bool SourceBatch::loadWithUring() {
+    Uring ring;
+
+    if (!ring.isOpen())
+        return false;
+
+    vector<int> results(URING_ENTRIES);
+    vector<struct statx> stats(BATCH_WINDOW_SIZE);
+    vector<string> contents(BATCH_WINDOW_SIZE);
+
+    for (size_t start = 0; start < fileNames.size();
+         start += BATCH_WINDOW_SIZE) {
+        size_t count = min(BATCH_WINDOW_SIZE, fileNames.size() - start);
+
+        // a batch that is stopping needs no pread fallback either
+        if (!waitForRoom(start))
+            return true;
+
+        for (size_t j = 0; j < count; j++) {
+            io_uring_sqe* openEntry = ring.add();
+            openEntry->opcode = IORING_OP_OPENAT;
+            openEntry->fd = AT_FDCWD;
+            openEntry->addr = reinterpret_cast<uint64_t>(fileNames[start + j].c_str());
+            openEntry->open_flags = O_RDONLY;
+            openEntry->user_data = j;
+        }
+
+        fill(results.begin(), results.end(), URING_NO_RESULT);
+
+        if (!ring.submit(results)) {
+            // the pread fallback opens the whole window again, so the files
+            // this window opened are closed first
+            for (size_t j = 0; j < count; j++) {
+                if (results[j] >= 0)
+                    close(results[j]);
+            }
+
+            nextFile = start;
+            return false;
+        }
+
+        // results is reused by the later submissions, so keep the file 
+        // descriptors here
+        vector<int> fds(results.begin(), results.begin() + count);
+
+        // the size comes from the opened file rather than its name, which 
+        // may point at another file by now
+        for (size_t j = 0; j < count; j++) {
+            if (fds[j] < 0)
+                continue;
+
+            io_uring_sqe* statEntry = ring.add();
+            statEntry->opcode = IORING_OP_STATX;
+            statEntry->fd = fds[j];
+            statEntry->addr = reinterpret_cast<uint64_t>("");
+            statEntry->statx_flags = AT_EMPTY_PATH;
+            statEntry->len = STATX_TYPE | STATX_SIZE;
+            statEntry->off = reinterpret_cast<uint64_t>(&stats[j]);
+            statEntry->user_data = j;
+        }
+
+        fill(results.begin(), results.end(), URING_NO_RESULT);
+
+        if (!ring.submit(results)) {
+            for (size_t j = 0; j < count; j++) {
+                if (fds[j] >= 0)
+                    close(fds[j]);
+            }
+
+            nextFile = start;
+            return false;
+        }
+
+        vector<bool> readable(count);
+
+        for (size_t j = 0; j < count; j++) {
+            readable[j] = fds[j] >= 0 && results[j] >= 0 &&
+                          S_ISREG(stats[j].stx_mode) &&
+                          stats[j].stx_size <= BATCH_READ_LIMIT;
+
+            // anything that is open but cannot be read here is handed to 
+            // SourceBuffer still open, so pipes are not opened twice
+            if (!readable[j])
+                continue;
+
+            contents[j].resize(stats[j].stx_size);
+
+            io_uring_sqe* readEntry = ring.add();
+            readEntry->opcode = IORING_OP_READ;
+            readEntry->fd = fds[j];
+            readEntry->addr = reinterpret_cast<uint64_t>(&contents[j][0]);
+            readEntry->len = contents[j].size();
+            readEntry->off = 0;
+            // the close has to happen even if the read fails
+            readEntry->flags = IOSQE_IO_HARDLINK;
+            readEntry->user_data = 2 * j;
+
+            io_uring_sqe* closeEntry = ring.add();
+            closeEntry->opcode = IORING_OP_CLOSE;
+            closeEntry->fd = fds[j];
+            closeEntry->user_data = 2 * j + 1;
+        }
+
+        fill(results.begin(), results.end(), URING_NO_RESULT);
+
+        if (!ring.submit(results)) {
+            // the pread fallback opens the whole window again, so every file
+            // this window opened and did not get to close is closed here
+            for (size_t j = 0; j < count; j++) {
+                if (fds[j] >= 0 && 
+                    (!readable[j] || results[2 * j + 1] == URING_NO_RESULT))
+                    close(fds[j]);
+            }
+
+            nextFile = start;
+            return false;
+        }
+
+        for (size_t j = 0; j < count; j++) {
+            unique_ptr<SourceBuffer> source;
+
+            if (readable[j] && 
+                results[2 * j] == static_cast<int>(contents[j].size())) {
+                source = SourceBuffer::fromContents(move(contents[j]));
+            } else if (fds[j] >= 0 && !readable[j]) {
+                source.reset(new SourceBuffer(fds[j]));
+            } else {
+                // a failed or short read, such as of a file that changed 
+                // since statx, is done again up to the end of the file
+                source.reset(new SourceBuffer(fileNames[start + j]));
+            }
+
+            finish(start + j, move(source));
+            contents[j] = string();
+        }
+    }
+
+    return true;
+}
+
+/**
+ * @brief Loads the files one at a time with pread; run by each thread of the
+ *        fallback pool
+ */
+void SourceBatch::loadWithPread() {
+    while (true) {
+        size_t i;
+
+        {
+            lock_guard<mutex> guard(lock);
+
+            if (nextFile == fileNames.size())
+                return;
+
+            i = nextFile++;
+        }
+
+        if (!waitForRoom(i))
+            return;
+
+        int fd = open(fileNames[i].c_str(), O_RDONLY);
+        struct stat info;
+
+        if (fd < 0 || fstat(fd, &info) != 0 || !S_ISREG(info.st_mode) ||
+            static_cast<size_t>(info.st_size) > BATCH_READ_LIMIT) {
+            finish(i, unique_ptr<SourceBuffer>(new SourceBuffer(fd)));
+            continue;
+        }
+
+        string contents(info.st_size, '\0');
+        size_t used = 0;
+
+        while (used < contents.size()) {
+            ssize_t count = pread(fd, &contents[used], contents.size() - used,
+                                  used);
+
+            if (count < 0 && errno == EINTR)
+                continue;
+            if (count <= 0)
+                break;
+
+            used += count;
+        }
+
+        close(fd);
+
+        // a read error or a file that changed since fstat is left to 
+        // SourceBuffer, the same as a short read through io_uring
+        if (used < contents.size()) {
+            finish(i, unique_ptr<SourceBuffer>(new SourceBuffer(fileNames[i])));
+            continue;
+        }
+
+        finish(i, SourceBuffer::fromContents(move(contents)));
+    }
+}
+
+/**
+ * @brief Hands a loaded file to whoever is waiting for it
+ * @param i - The index of the file
+ * @param source - The loaded file
+ */
+void SourceBatch::finish(size_t i, unique_ptr<SourceBuffer> source) {
+    lock_guard<mutex> guard(lock);
+    sources[i] = move(source);
+    loaded.notify_all();
+}
@@ -0,0 +1,165 @@
+/**
+ * @file SourceBatch.hpp
+ * @brief Defines the SourceBatch class that loads many C-style programs at
+ *        once, batching the system calls for all of them
+ * @authors Jacob Franco, Zach Gassner, Haley Joerger, Adam Lyday
+ */
+
+#ifndef SOURCE_BATCH_HPP
+#define SOURCE_BATCH_HPP
+
+#include "SourceBuffer.hpp"
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace std;
+
+/**
+ * @brief Files bigger than this are memory mapped by SourceBuffer instead of
+ *        being read by the batch
+ */
+const size_t BATCH_READ_LIMIT = 1 << 20;
+
+/**
+ * @brief The most files the batch has open at the same time
+ */
+const size_t BATCH_WINDOW_SIZE = 64;
+
+/**
+ * @brief The most windows of files loaded ahead of the file the caller last
+ *        took, so that a large batch is never all in memory at once
+ */
+const size_t BATCH_WINDOWS_AHEAD = 2;
+
+/**
+ * @class SourceBatch
+ * @brief Loads a list of files in the background while the caller works
+ *        through them in order
+ * @remark On Linux the opens, stats, reads and closes for a window of files
+ *         are submitted together through io_uring, so a window costs a few
+ *         io_uring_enter calls instead of five system calls per file. When
+ *         io_uring is not available, a small pool of threads loads the files
+ *         with pread instead. Large files and anything that is not a regular
+ *         file go through SourceBuffer's own loading.
+ * @remark Loading stays at most BATCH_WINDOWS_AHEAD windows ahead of the 
+ *         caller, and each file belongs to the caller once it is taken.
+ */
+class SourceBatch {
+public:
+    /**
+     * @brief Constructor
+     * @param fileNames - The names of files that contain C-style programs
+     * @remark Returns right away; the files are loaded in the background
+     */
+    SourceBatch(const vector<string>& fileNames);
+
+    /**
+     * @brief Destructor
+     * @remark Stops the background loading, waiting only for the files 
+     *         being loaded right now
+     */
+    ~SourceBatch();
+
+    /**
+     * @brief A SourceBatch owns its loader threads, so it cannot be copied
+     */
+    SourceBatch(const SourceBatch&) = delete;
+    SourceBatch& operator = (const SourceBatch&) = delete;
+
+    /**
+     * @brief Getter for the number of files
+     */
+    size_t size() const { return fileNames.size(); }
+
+    /**
+     * @brief Hands over a loaded file, waiting for it if it is not loaded yet
+     * @param i - The index of the file in the list given to the constructor
+     * @remark Each file can be taken once; files are expected to be taken 
+     *         in order, since loading only runs ahead of the last one taken
+     */
+    unique_ptr<SourceBuffer> take(size_t i);
+
+private:
+    /**
+     * @brief Loads every file through io_uring
+     * @returns False if io_uring could not be set up or stopped working, in
+     *          which case nextFile is the first file that still needs loading
+     */
+    bool loadWithUring();
+
+    /**
+     * @brief Loads the files one at a time with pread; run by each thread of
+     *        the fallback pool
+     */
+    void loadWithPread();
+
+    /**
+     * @brief Hands a loaded file to whoever is waiting for it
+     * @param i - The index of the file
+     * @param source - The loaded file
+     */
+    void finish(size_t i, unique_ptr<SourceBuffer> source);
+
+    /**
+     * @brief Waits until file i is close enough to the files taken to load
+     * @returns False if the batch is being destroyed instead
+     */
+    bool waitForRoom(size_t i);
+
+    /**
+     * @brief The files to load
+     */
+    vector<string> fileNames;
+
+    /**
+     * @brief The loaded files; empty until a file is loaded, and again once
+     *        it is taken
+     */
+    vector<unique_ptr<SourceBuffer>> sources;
+
+    /**
+     * @brief Index of the next file a pread thread should load
+     */
+    size_t nextFile;
+
+    /**
+     * @brief One past the index of the last file asked for
+     */
+    size_t taken;
+
+    /**
+     * @brief Set by the destructor to stop the loading
+     */
+    bool stopping;
+
+    /**
+     * @brief Guards sources, nextFile, taken and stopping
+     */
+    mutex lock;
+
+    /**
+     * @brief Signaled every time a file is loaded
+     */
+    condition_variable loaded;
+
+    /**
+     * @brief Signaled every time a file is asked for, and when stopping
+     */
+    condition_variable room;
+
+    /**
+     * @brief Runs io_uring, or becomes the first thread of the pread pool
+     */
+    thread loader;
+
+    /**
+     * @brief The rest of the pread pool, started by loader
+     */
+    vector<thread> pool;
+};
+
+#endif
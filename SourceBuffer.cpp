@@ -0,0 +1,134 @@
+/**
+ * @file SourceBuffer.cpp
+ * @brief Implementation file for the SourceBuffer class
+ * @authors Jacob Franco, Zach Gassner, Haley Joerger, Adam Lyday
+ */
+
+#include "SourceBuffer.hpp"
+#include "SimdScan.hpp"
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <cerrno>
+
+/**
+ * @brief Constructor
+ * @param fileName - The name of a file that contains a C-style program
+ * @remark Maps regular files read-only; falls back to read() for everything
+ *          else (pipes, character devices) or if mmap fails
+ */
+SourceBuffer::SourceBuffer(const string& fileName)
+    : bytes(""), length(0), mapped(false), opened(false), invalidUtf8(0) {
+    int fd = open(fileName.c_str(), O_RDONLY);
+
+    if (fd >= 0)
+        load(fd);
+}
+
+/**
+ * @brief Constructor
+ * @param fd - A file descriptor opened for reading, which the SourceBuffer
+ *             closes once the program is loaded
+ * @remark Loads the same way as the file name constructor
+ */
+SourceBuffer::SourceBuffer(int fd)
+    : bytes(""), length(0), mapped(false), opened(false), invalidUtf8(0) {
+    if (fd >= 0)
+        load(fd);
+}
+
+/**
+ * @brief Makes a SourceBuffer of a program that has already been read
+ * @param contents - The bytes of the program, which the SourceBuffer takes 
+ *                   over
+ */
+unique_ptr<SourceBuffer> SourceBuffer::fromContents(string&& contents) {
+    return unique_ptr<SourceBuffer>(new SourceBuffer(Contents(), 
+                                                     move(contents)));
+}
+
+/**
+ * @brief Constructor
+ * @param contents - The bytes of the program, which the SourceBuffer takes 
+ *                   over
+ */
+SourceBuffer::SourceBuffer(Contents, string&& contents)
+    : length(contents.size()), mapped(false), opened(true), 
+      fallback(move(contents)) {
+    bytes = fallback.data();
+    invalidUtf8 = findInvalidUtf8(bytes, length);
+}
+
+/**
+ * @brief Destructor
+ * @remark Unmaps the file if it was mapped
+ */
+SourceBuffer::~SourceBuffer() {
+    if (mapped)
+        munmap(const_cast<char*>(bytes), length);
+}
+
+/**
+ * @brief Loads the program from an open file descriptor and closes it
+ * @param fd - A file descriptor opened for reading
+ * @remark Maps regular files read-only; falls back to read() for everything
+ *          else (pipes, character devices) or if mmap fails
+ */
+void SourceBuffer::load(int fd) {
+    opened = true;
+    struct stat info;
+
+    if (fstat(fd, &info) == 0 && S_ISREG(info.st_mode) && info.st_size > 0) {
+        void* map = mmap(nullptr, info.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+
+        if (map != MAP_FAILED) {
+            // the comment DFA walks the file front to back exactly once
+            madvise(map, info.st_size, MADV_SEQUENTIAL);
+            bytes = static_cast<const char*>(map);
+            length = info.st_size;
+            mapped = true;
+        }
+    }
+
+    if (!mapped)
+        readAll(fd);
+
+    close(fd);
+    invalidUtf8 = findInvalidUtf8(bytes, length);
+}
+
+/**
+ * @brief Reads everything from a file descriptor into fallback
+ * @param fd - An open file descriptor
+ * @remark A read error part way through marks the file as not open, rather
+ *          than leaving the start of the program to be analyzed as if it 
+ *          were all of it
+ */
+void SourceBuffer::readAll(int fd) {
+    const size_t chunkSize = 1 << 16;
+    size_t used = 0;
+
+    while (true) {
+        fallback.resize(used + chunkSize);
+        ssize_t count = read(fd, &fallback[used], chunkSize);
+
+        if (count < 0 && errno == EINTR)
+            continue;
+
+        if (count < 0) {
+            opened = false;
+            used = 0;
+            break;
+        }
+
+        if (count == 0)
+            break;
+
+        used += count;
+    }
+
+    fallback.resize(used);
+    bytes = fallback.data();
+    length = used;
+}
@@ -0,0 +1,146 @@
+/**
+ * @file SourceBuffer.hpp
+ * @brief Defines the SourceBuffer class that loads a C-style program into
+ *        memory without copying it when the operating system allows
+ * @authors Jacob Franco, Zach Gassner, Haley Joerger, Adam Lyday
+ */
+
+#ifndef SOURCE_BUFFER_HPP
+#define SOURCE_BUFFER_HPP
+
+#include <iostream>
+#include <memory>
+#include <string>
+#include <string_view>
+
+using namespace std;
+
+/**
+ * @class SourceBuffer
+ * @brief Read-only view of an input file's bytes
+ * @remark Regular files are memory mapped so no copy of the program is made.
+ *         Anything that cannot be mapped (pipes, terminals, empty files) is
+ *         read into an owned string instead.
+ */
+class SourceBuffer {
+public:
+    /**
+     * @brief Constructor
+     * @param fileName - The name of a file that contains a C-style program
+     */
+    SourceBuffer(const string& fileName);
+
+    /**
+     * @brief Constructor
+     * @param fd - A file descriptor opened for reading, which the 
+     *             SourceBuffer closes once the program is loaded
+     */
+    explicit SourceBuffer(int fd);
+
+    /**
+     * @brief Makes a SourceBuffer of a program that has already been read
+     * @param contents - The bytes of the program, which the SourceBuffer 
+     *                   takes over
+     */
+    static unique_ptr<SourceBuffer> fromContents(string&& contents);
+
+    /**
+     * @brief Destructor
+     * @remark Unmaps the file if it was mapped
+     */
+    ~SourceBuffer();
+
+    /**
+     * @brief A SourceBuffer owns its mapping, so it cannot be copied
+     */
+    SourceBuffer(const SourceBuffer&) = delete;
+    SourceBuffer& operator = (const SourceBuffer&) = delete;
+
+    /**
+     * @brief Getter for whether the file could be opened and read
+     */
+    bool isOpen() const { return opened; }
+
+    /**
+     * @brief Getter for the first byte of the program
+     */
+    const char* data() const { return bytes; }
+
+    /**
+     * @brief Getter for the number of bytes in the program
+     */
+    size_t size() const { return length; }
+
+    /**
+     * @brief Returns the whole program as a string_view
+     */
+    string_view view() const { return string_view(bytes, length); }
+
+    /**
+     * @brief Getter for where the program stops being valid UTF-8
+     * @returns The offset of the first invalid byte, or size() if the whole
+     *          program is valid UTF-8
+     * @remark Checked once while loading, so later stages can assume any
+     *         byte past 0x7F is part of a valid multi-byte character
+     */
+    size_t getInvalidUtf8Offset() const { return invalidUtf8; }
+
+private:
+    /**
+     * @brief Picks the constructor fromContents uses, which a file name 
+     *        could otherwise pick
+     */
+    struct Contents { };
+
+    /**
+     * @brief Constructor
+     * @param contents - The bytes of the program, which the SourceBuffer 
+     *                   takes over
+     */
+    SourceBuffer(Contents, string&& contents);
+
+    /**
+     * @brief Loads the program from an open file descriptor and closes it
+     * @param fd - A file descriptor opened for reading
+     */
+    void load(int fd);
+
+    /**
+     * @brief Reads everything from a file descriptor into fallback
+     * @param fd - An open file descriptor
+     * @remark Marks the file as not open if a read fails
+     */
+    void readAll(int fd);
+
+    /**
+     * @brief Points at either the mapping or fallback's characters
+     */
+    const char* bytes;
+
+    /**
+     * @brief Number of bytes in the program
+     */
+    size_t length;
+
+    /**
+     * @brief True if bytes points at a mapping that must be unmapped
+     */
+    bool mapped;
+
+    /**
+     * @brief True if the file could be opened and read
+     */
+    bool opened;
+
+    /**
+     * @brief Offset of the first byte that is not valid UTF-8, or length
+     */
+    size_t invalidUtf8;
+
+    /**
+     * @brief Holds the program when it could not be mapped
+     */
+    string fallback;
+};
+
+#endif
@@ -0,0 +1,122 @@
+/**
+ * @file SpscQueue.hpp
+ * @brief Defines the SpscQueue class, a bounded lock-free queue that passes
+ *        work from one thread to exactly one other thread
+ * @authors Jacob Franco, Zach Gassner, Haley Joerger, Adam Lyday
+ */
+
+#ifndef SPSC_QUEUE_HPP
+#define SPSC_QUEUE_HPP
+
+#include <atomic>
+#include <cstddef>
+#include <thread>
+#include <utility>
+#include <vector>
+
+using namespace std;
+
+/**
+ * @class SpscQueue
+ * @brief Ring buffer for a single producer thread and a single consumer
+ *        thread
+ * @remark The producer only writes tail and the consumer only writes head,
+ *         so neither side ever takes a lock. A full queue makes push wait,
+ *         which keeps a fast stage from running arbitrarily far ahead of a
+ *         slow one.
+ */
+template <typename T>
+class SpscQueue {
+public:
+    /**
+     * @brief Constructor
+     * @param capacity - The most items the queue holds at once, rounded up to
+     *                   a power of two
+     */
+    SpscQueue(size_t capacity) : head(0), tail(0), closed(false) {
+        size_t size = 1;
+
+        while (size < capacity)
+            size *= 2;
+
+        slots.resize(size);
+        mask = size - 1;
+    }
+
+    /**
+     * @brief Adds an item, waiting while the queue is full
+     * @param item - The item to move into the queue
+     * @remark Producer thread only
+     */
+    void push(T&& item) {
+        size_t position = tail.load(memory_order_relaxed);
+
+        while (position - head.load(memory_order_acquire) == slots.size())
+            this_thread::yield();
+
+        slots[position & mask] = move(item);
+        tail.store(position + 1, memory_order_release);
+    }
+
+    /**
+     * @brief Removes the oldest item, waiting while the queue is empty
+     * @param item - Receives the item
+     * @returns False once the queue is closed and every item has been taken
+     * @remark Consumer thread only
+     */
+    bool pop(T& item) {
+        size_t position = head.load(memory_order_relaxed);
+
+        while (position == tail.load(memory_order_acquire)) {
+            if (closed.load(memory_order_acquire)) {
+                // an item pushed just before close() may have been missed
+                if (position == tail.load(memory_order_acquire))
+                    return false;
+
+                break;
+            }
+
+            this_thread::yield();
+        }
+
+        item = move(slots[position & mask]);
+        head.store(position + 1, memory_order_release);
+        return true;
+    }
+
+    /**
+     * @brief Tells the consumer that nothing more will be pushed
+     * @remark Producer thread only
+     */
+    void close() {
+        closed.store(true, memory_order_release);
+    }
+
+private:
+    /**
+     * @brief The ring; a slot is in use when it is between head and tail
+     */
+    vector<T> slots;
+
+    /**
+     * @brief slots.size() - 1, for turning a position into a slot index
+     */
+    size_t mask;
+
+    /**
+     * @brief Position of the next item to pop; written by the consumer
+     */
+    alignas(64) atomic<size_t> head;
+
+    /**
+     * @brief Position of the next item to push; written by the producer
+     */
+    alignas(64) atomic<size_t> tail;
+
+    /**
+     * @brief Set by the producer once it is done
+     */
+    alignas(64) atomic<bool> closed;
+};
+
+#endif
@@ -0,0 +1,78 @@
+/**
+ * @file StatementTable.cpp
+ * @brief Implementation file for the StatementTable class
+ * @authors Jacob Franco, Zach Gassner, Haley Joerger, Adam Lyday
+ */
+
+#include "StatementTable.hpp"
+
+/**
+ * @brief Returns the kind of a statement from the type of its first token
+ */
+StatementKind getStatementKind(TokenType first) {
+    switch (first) {
+        case KEYWORD_FUNCTION:
+            return STATEMENT_FUNCTION_DECLARATION;
+
+        case KEYWORD_PROCEDURE:
+            return STATEMENT_PROCEDURE_DECLARATION;
+
+        case KEYWORD_INT:
+        case KEYWORD_STRING:
+        case CHAR:
+        case KEYWORD_BOOL:
+            return STATEMENT_VARIABLE_DECLARATION;
+
+        case IDENTIFIER:
+            return STATEMENT_ASSIGNMENT;
+
+        case KEYWORD_PRINTF:
+            return STATEMENT_CALL;
+
+        case KEYWORD_IF:
+            return STATEMENT_IF;
+
+        case KEYWORD_ELSE:
+            return STATEMENT_ELSE;
+
+        case KEYWORD_FOR:
+            return STATEMENT_FOR;
+
+        case KEYWORD_WHILE:
+            return STATEMENT_WHILE;
+
+        case KEYWORD_RETURN:
+            return STATEMENT_RETURN;
+
+        case LEFT_BRACE:
+            return STATEMENT_BLOCK_BEGIN;
+
+        case RIGHT_BRACE:
+            return STATEMENT_BLOCK_END;
+
+        default:
+            return STATEMENT_OTHER;
+    }
+}
+
+/**
+ * @brief Returns the kind of a statement from the type of its second token
+ * @param kind - The kind the statement's first token gave
+ * @param second - The type of the statement's second token
+ */
+StatementKind getStatementKind(StatementKind kind, TokenType second) {
+    if (kind != STATEMENT_ASSIGNMENT)
+        return kind;
+
+    switch (second) {
+        case LEFT_PARENTHESIS:
+            return STATEMENT_CALL;
+
+        case ASSIGNMENT:
+        case LEFT_BRACKET:
+            return STATEMENT_ASSIGNMENT;
+
+        default:
+            return STATEMENT_OTHER;
+    }
+}
@@ -0,0 +1,177 @@
+/**
+ * @file StatementTable.hpp
+ * @brief Defines the StatementTable class the parser fills in while it 
+ *        builds the CST, one entry per statement
+ * @authors Jacob Franco, Zach Gassner, Haley Joerger, Adam Lyday
+ */
+
+#ifndef STATEMENT_TABLE_HPP
+#define STATEMENT_TABLE_HPP
+
+#include <cassert>
+#include <cstdint>
+#include <vector>
+#include "Tokenization.hpp"
+
+using namespace std;
+
+/**
+ * @enum StatementKind
+ * @brief Enumerates the kinds of statement, told apart by their first one or
+ *        two tokens
+ */
+enum StatementKind : uint8_t {
+    STATEMENT_FUNCTION_DECLARATION,
+    STATEMENT_PROCEDURE_DECLARATION,
+    STATEMENT_VARIABLE_DECLARATION,
+    STATEMENT_ASSIGNMENT,
+    STATEMENT_CALL,
+    STATEMENT_IF,
+    STATEMENT_ELSE,
+    STATEMENT_FOR,
+    STATEMENT_WHILE,
+    STATEMENT_RETURN,
+    STATEMENT_BLOCK_BEGIN,
+    STATEMENT_BLOCK_END,
+    STATEMENT_OTHER,
+};
+
+/**
+ * @brief Returns the kind of a statement from the type of its first token
+ * @remark A statement that starts with an identifier is taken to be an 
+ *         assignment until getStatementKind is given its second token
+ */
+StatementKind getStatementKind(TokenType first);
+
+/**
+ * @brief Returns the kind of a statement from the type of its second token
+ * @param kind - The kind the statement's first token gave
+ * @param second - The type of the statement's second token
+ * @remark Tells an identifier's call from its assignment
+ */
+StatementKind getStatementKind(StatementKind kind, TokenType second);
+
+/**
+ * @struct Statement
+ * @brief One statement of a CST
+ * @remark depth is the number of blocks the statement is in; a block's 
+ *         braces are at the depth of the statement the block belongs to. A
+ *         stray } makes it negative.
+ */
+template <typename Cursor>
+struct Statement {
+    // a cursor at the statement's first node (see TreeCursor.hpp)
+    Cursor first;
+    // the statement's tokens are the tokenCount tokens from firstToken on
+    uint32_t firstToken;
+    uint32_t tokenCount;
+    StatementKind kind;
+    int depth;
+};
+
+/**
+ * @class StatementTable
+ * @brief Every statement of a CST, in order, recorded while the CST is built
+ *        so that later stages can go straight to the statements they need
+ */
+template <typename Cursor>
+class StatementTable {
+public:
+    /**
+     * @brief Constructor
+     * @param firstToken - The index of the first token that will be recorded
+     * @remark A table for part of a program starts at the part's first 
+     *         token, and is later appended to the table before it
+     */
+    explicit StatementTable(uint32_t firstToken = 0) 
+        : tokens(firstToken), depth(0) { }
+
+    /**
+     * @brief Empties the table, keeping its memory
+     */
+    void clear() {
+        statements.clear();
+        tokens = 0;
+        depth = 0;
+    }
+
+    /**
+     * @brief Records the next token of the program
+     * @param type - The type of the token after the one recorded last time
+     * @param startsStatement - True if the token starts a statement
+     * @param node - A cursor at the token's node
+     */
+    void addToken(TokenType type, bool startsStatement, Cursor node) {
+        if (startsStatement) {
+            StatementKind kind = getStatementKind(type);
+
+            if (kind == STATEMENT_BLOCK_END)
+                depth--;
+
+            statements.push_back(Statement<Cursor>{node, tokens, 0, kind, 
+                                                   depth});
+
+            if (kind == STATEMENT_BLOCK_BEGIN)
+                depth++;
+        } else if (statements.back().tokenCount == 1) {
+            statements.back().kind = getStatementKind(statements.back().kind,
+                                                      type);
+        }
+
+        statements.back().tokenCount++;
+        tokens++;
+    }
+
+    /**
+     * @brief Records the statements of the part of the program that comes 
+     *        next
+     * @param rest - A table started at the token after the last one recorded
+     *               here, whose first token started a statement
+     * @remark The depths in rest are counted from the depth here
+     */
+    void append(const StatementTable& rest) {
+        assert(rest.statements.empty() || 
+               rest.statements.front().firstToken == tokens);
+        statements.reserve(statements.size() + rest.statements.size());
+
+        for (Statement<Cursor> statement : rest.statements) {
+            statement.depth += depth;
+            statements.push_back(statement);
+        }
+
+        tokens = rest.tokens;
+        depth += rest.depth;
+    }
+
+    size_t size() const { return statements.size(); }
+    bool empty() const { return statements.empty(); }
+    const Statement<Cursor>& operator [] (size_t i) const { 
+        return statements[i]; 
+    }
+    const Statement<Cursor>& back() const { return statements.back(); }
+
+    typename vector<Statement<Cursor>>::const_iterator begin() const { 
+        return statements.begin(); 
+    }
+    typename vector<Statement<Cursor>>::const_iterator end() const { 
+        return statements.end(); 
+    }
+
+private:
+    /**
+     * @brief Every statement recorded so far; the last may not be complete
+     */
+    vector<Statement<Cursor>> statements;
+
+    /**
+     * @brief The number of tokens recorded so far
+     */
+    uint32_t tokens;
+
+    /**
+     * @brief The depth of the next statement
+     */
+    int depth;
+};
+
+#endif
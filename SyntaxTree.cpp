@@ -0,0 +1,276 @@
+/**
+ * @file SyntaxTree.cpp
+ * @brief Implementation file for printing the typed syntax tree
+ * @authors Jacob Franco, Zach Gassner, Haley Joerger, Adam Lyday
+ */
+
+#include "SyntaxTree.hpp"
+
+/**
+ * @brief Returns the characters of an operator, for printing
+ * @param op - The type of an operator token
+ */
+const char* getOperatorText(TokenType op) {
+    switch (op) {
+        case PLUS: return "+";
+        case MINUS: return "-";
+        case ASTERISK: return "*";
+        case DIVIDE: return "/";
+        case MODULO: return "%";
+        case CARAT: return "^";
+        case LT: return "<";
+        case GT: return ">";
+        case LT_EQUAL: return "<=";
+        case GT_EQUAL: return ">=";
+        case BOOLEAN_EQUAL: return "==";
+        case BOOLEAN_NOT_EQUAL: return "!=";
+        case BOOLEAN_AND_OPERATOR: return "&&";
+        case BOOLEAN_OR_OPERATOR: return "||";
+        case BOOLEAN_NOT_OPERATOR: return "!";
+        default: return "?";
+    }
+}
+
+/**
+ * @brief Returns the characters of a type keyword, for printing
+ * @param type - The type of a type keyword token
+ */
+static const char* getTypeText(TokenType type) {
+    switch (type) {
+        case KEYWORD_INT: return "int";
+        case CHAR: return "char";
+        case KEYWORD_BOOL: return "bool";
+        case KEYWORD_STRING: return "string";
+        default: return "void";
+    }
+}
+
+/**
+ * @brief Starts a line indented for depth
+ */
+static ostream& indent(ostream& os, int depth) {
+    for (int i = 0; i < depth; i++)
+        os << "  ";
+
+    return os;
+}
+
+static void printExpr(ostream& os, const Expr* expr, int depth);
+static void printStmt(ostream& os, const Stmt* stmt, int depth);
+
+/**
+ * @brief Writes a variable or parameter and the ones chained after it
+ */
+static void printVariables(ostream& os, const Variable* variable, int depth) {
+    for (; variable; variable = variable->next) {
+        indent(os, depth) << "Variable " << getTypeText(variable->type)
+                          << ' ' << variable->name;
+
+        if (variable->isArray)
+            os << '[' << variable->arraySize << ']';
+
+        os << '\n';
+    }
+}
+
+/**
+ * @brief Writes an expression and everything under it
+ */
+static void printExpr(ostream& os, const Expr* expr, int depth) {
+    switch (expr->kind) {
+        case SYNTAX_INTEGER_EXPR:
+            indent(os, depth) << "IntegerExpr "
+                              << static_cast<const IntegerExpr*>(expr)->text
+                              << '\n';
+            break;
+
+        case SYNTAX_BOOL_EXPR:
+            indent(os, depth) << "BoolExpr "
+                              << (static_cast<const BoolExpr*>(expr)->value ?
+                                  "TRUE" : "FALSE") << '\n';
+            break;
+
+        case SYNTAX_STRING_EXPR:
+            indent(os, depth) << "StringExpr \""
+                              << static_cast<const StringExpr*>(expr)->text
+                              << "\"\n";
+            break;
+
+        case SYNTAX_CHAR_EXPR:
+            indent(os, depth) << "CharExpr '"
+                              << static_cast<const StringExpr*>(expr)->text
+                              << "'\n";
+            break;
+
+        case SYNTAX_NAME_EXPR:
+            indent(os, depth) << "NameExpr "
+                              << static_cast<const NameExpr*>(expr)->name
+                              << '\n';
+            break;
+
+        case SYNTAX_INDEX_EXPR: {
+            const IndexExpr* index = static_cast<const IndexExpr*>(expr);
+            indent(os, depth) << "IndexExpr " << index->array->name << '\n';
+            printExpr(os, index->index, depth + 1);
+            break;
+        }
+
+        case SYNTAX_CALL_EXPR: {
+            const CallExpr* call = static_cast<const CallExpr*>(expr);
+            indent(os, depth) << "CallExpr " << call->callee->name << '\n';
+
+            for (const Expr* argument = call->arguments; argument;
+                 argument = argument->next)
+                printExpr(os, argument, depth + 1);
+            break;
+        }
+
+        case SYNTAX_UNARY_EXPR: {
+            const UnaryExpr* unary = static_cast<const UnaryExpr*>(expr);
+            indent(os, depth) << "UnaryExpr " << getOperatorText(unary->op)
+                              << '\n';
+            printExpr(os, unary->operand, depth + 1);
+            break;
+        }
+
+        case SYNTAX_BINARY_EXPR: {
+            const BinaryExpr* binary = static_cast<const BinaryExpr*>(expr);
+            indent(os, depth) << "BinaryExpr " << getOperatorText(binary->op)
+                              << '\n';
+            printExpr(os, binary->left, depth + 1);
+            printExpr(os, binary->right, depth + 1);
+            break;
+        }
+
+        default:
+            break;
+    }
+}
+
+/**
+ * @brief Writes a statement and everything under it, but not the
+ *        statements chained after it
+ */
+static void printStmt(ostream& os, const Stmt* stmt, int depth) {
+    switch (stmt->kind) {
+        case SYNTAX_FUNCTION_DECL:
+        case SYNTAX_PROCEDURE_DECL: {
+            const FunctionDecl* function =
+                static_cast<const FunctionDecl*>(stmt);
+
+            if (stmt->kind == SYNTAX_FUNCTION_DECL)
+                indent(os, depth) << "FunctionDecl "
+                                  << getTypeText(function->returnType) << ' ';
+            else
+                indent(os, depth) << "ProcedureDecl ";
+
+            os << function->name << '\n';
+            printVariables(os, function->parameters, depth + 1);
+            printStmt(os, function->body, depth + 1);
+            break;
+        }
+
+        case SYNTAX_VAR_DECL:
+            indent(os, depth) << "VarDecl\n";
+            printVariables(os, static_cast<const VarDecl*>(stmt)->variables,
+                           depth + 1);
+            break;
+
+        case SYNTAX_BLOCK_STMT:
+            indent(os, depth) << "BlockStmt\n";
+
+            for (const Stmt* inner =
+                     static_cast<const BlockStmt*>(stmt)->statements;
+                 inner; inner = inner->next)
+                printStmt(os, inner, depth + 1);
+            break;
+
+        case SYNTAX_IF_STMT: {
+            const IfStmt* ifStmt = static_cast<const IfStmt*>(stmt);
+            indent(os, depth) << "IfStmt\n";
+            printExpr(os, ifStmt->condition, depth + 1);
+            printStmt(os, ifStmt->then, depth + 1);
+
+            if (ifStmt->otherwise) {
+                indent(os, depth) << "Else\n";
+                printStmt(os, ifStmt->otherwise, depth + 1);
+            }
+            break;
+        }
+
+        case SYNTAX_FOR_STMT: {
+            const ForStmt* forStmt = static_cast<const ForStmt*>(stmt);
+            indent(os, depth) << "ForStmt\n";
+
+            if (forStmt->init)
+                printStmt(os, forStmt->init, depth + 1);
+            if (forStmt->condition)
+                printExpr(os, forStmt->condition, depth + 1);
+            if (forStmt->step)
+                printStmt(os, forStmt->step, depth + 1);
+
+            printStmt(os, forStmt->body, depth + 1);
+            break;
+        }
+
+        case SYNTAX_WHILE_STMT: {
+            const WhileStmt* whileStmt = static_cast<const WhileStmt*>(stmt);
+            indent(os, depth) << "WhileStmt\n";
+            printExpr(os, whileStmt->condition, depth + 1);
+            printStmt(os, whileStmt->body, depth + 1);
+            break;
+        }
+
+        case SYNTAX_RETURN_STMT: {
+            const ReturnStmt* returnStmt =
+                static_cast<const ReturnStmt*>(stmt);
+            indent(os, depth) << "ReturnStmt\n";
+
+            if (returnStmt->value)
+                printExpr(os, returnStmt->value, depth + 1);
+            break;
+        }
+
+        case SYNTAX_ASSIGN_STMT: {
+            const AssignStmt* assign = static_cast<const AssignStmt*>(stmt);
+            indent(os, depth) << "AssignStmt\n";
+            printExpr(os, assign->target, depth + 1);
+            printExpr(os, assign->value, depth + 1);
+            break;
+        }
+
+        case SYNTAX_CALL_STMT:
+            indent(os, depth) << "CallStmt\n";
+            printExpr(os, static_cast<const CallStmt*>(stmt)->call,
+                      depth + 1);
+            break;
+
+        case SYNTAX_PRINTF_STMT: {
+            const PrintfStmt* printfStmt =
+                static_cast<const PrintfStmt*>(stmt);
+            indent(os, depth) << "PrintfStmt\n";
+            printExpr(os, printfStmt->format, depth + 1);
+
+            for (const Expr* argument = printfStmt->arguments; argument;
+                 argument = argument->next)
+                printExpr(os, argument, depth + 1);
+            break;
+        }
+
+        default:
+            break;
+    }
+}
+
+/**
+ * @brief Writes a syntax tree with one node on each line, indented by depth
+ * @param os - The output stream
+ * @param program - The first top-level declaration, or nullptr
+ * @returns The modified output stream
+ */
+ostream& printSyntaxTree(ostream& os, const Stmt* program) {
+    for (; program; program = program->next)
+        printStmt(os, program, 0);
+
+    return os;
+}
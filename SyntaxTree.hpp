@@ -0,0 +1,284 @@
+/**
+ * @file SyntaxTree.hpp
+ * @brief Defines the typed nodes PredictiveParser builds, one struct for each
+ *        kind of declaration, statement and expression
+ * @authors Jacob Franco, Zach Gassner, Haley Joerger, Adam Lyday
+ */
+
+#ifndef SYNTAX_TREE_HPP
+#define SYNTAX_TREE_HPP
+
+#include <cstdint>
+#include <iostream>
+#include <string_view>
+#include "Tokenization.hpp"
+
+using namespace std;
+
+/**
+ * @enum SyntaxKind
+ * @brief Enumerates the kinds of node; every node starts with its kind, so
+ *        a pass can switch on it and cast to the node's struct
+ */
+enum SyntaxKind : uint8_t {
+    // declarations
+    SYNTAX_FUNCTION_DECL,
+    SYNTAX_PROCEDURE_DECL,
+    SYNTAX_VAR_DECL,
+    SYNTAX_VARIABLE,
+    // statements
+    SYNTAX_BLOCK_STMT,
+    SYNTAX_IF_STMT,
+    SYNTAX_FOR_STMT,
+    SYNTAX_WHILE_STMT,
+    SYNTAX_RETURN_STMT,
+    SYNTAX_ASSIGN_STMT,
+    SYNTAX_CALL_STMT,
+    SYNTAX_PRINTF_STMT,
+    // expressions
+    SYNTAX_INTEGER_EXPR,
+    SYNTAX_BOOL_EXPR,
+    SYNTAX_STRING_EXPR,
+    SYNTAX_CHAR_EXPR,
+    SYNTAX_NAME_EXPR,
+    SYNTAX_INDEX_EXPR,
+    SYNTAX_CALL_EXPR,
+    SYNTAX_UNARY_EXPR,
+    SYNTAX_BINARY_EXPR,
+};
+
+/**
+ * @remark The nodes are made in an Arena, so they hold no strings or
+ *         vectors: text points into the program, like Token::character, and
+ *         lists are chains of next pointers. A node's offset is where its
+ *         first token starts in the program.
+ */
+
+/**
+ * @struct SyntaxNode
+ * @brief What every node starts with
+ */
+struct SyntaxNode {
+    SyntaxKind kind;
+    uint32_t offset;
+};
+
+/**
+ * @struct Expr
+ * @brief An expression; next is the next argument of a call
+ */
+struct Expr : SyntaxNode {
+    Expr* next;
+};
+
+/**
+ * @struct Stmt
+ * @brief A statement or top-level declaration; next is the next one in the
+ *        same block, or in the program
+ */
+struct Stmt : SyntaxNode {
+    Stmt* next;
+};
+
+/**
+ * @struct Variable
+ * @brief One declared variable or parameter; next is the next one in the
+ *        same declaration or parameter list
+ */
+struct Variable : SyntaxNode {
+    TokenType type;
+    string_view name;
+    SymbolId symbol;
+    bool isArray;
+    int arraySize;
+    Variable* next;
+};
+
+/**
+ * @struct IntegerExpr
+ * @brief An integer literal, such as 10 or -1
+ */
+struct IntegerExpr : Expr {
+    string_view text;
+};
+
+/**
+ * @struct BoolExpr
+ * @brief TRUE or FALSE
+ */
+struct BoolExpr : Expr {
+    bool value;
+};
+
+/**
+ * @struct StringExpr
+ * @brief A string literal, kind SYNTAX_STRING_EXPR, or a character literal
+ *        in single quotes, kind SYNTAX_CHAR_EXPR; text is without the quotes
+ */
+struct StringExpr : Expr {
+    string_view text;
+};
+
+/**
+ * @struct NameExpr
+ * @brief A variable, function or procedure used by name
+ */
+struct NameExpr : Expr {
+    string_view name;
+    SymbolId symbol;
+};
+
+/**
+ * @struct IndexExpr
+ * @brief An element of an array, array[index]
+ */
+struct IndexExpr : Expr {
+    NameExpr* array;
+    Expr* index;
+};
+
+/**
+ * @struct CallExpr
+ * @brief A call of a function or procedure, with its arguments chained
+ *        through Expr::next
+ */
+struct CallExpr : Expr {
+    NameExpr* callee;
+    Expr* arguments;
+    uint32_t argumentCount;
+};
+
+/**
+ * @struct UnaryExpr
+ * @brief ! or - applied to an operand
+ */
+struct UnaryExpr : Expr {
+    TokenType op;
+    Expr* operand;
+};
+
+/**
+ * @struct BinaryExpr
+ * @brief An operator applied to two operands
+ */
+struct BinaryExpr : Expr {
+    TokenType op;
+    Expr* left;
+    Expr* right;
+};
+
+/**
+ * @struct VarDecl
+ * @brief A declaration of one or more variables of the same type
+ */
+struct VarDecl : Stmt {
+    Variable* variables;
+};
+
+/**
+ * @struct BlockStmt
+ * @brief The statements between { and }
+ */
+struct BlockStmt : Stmt {
+    Stmt* statements;
+};
+
+/**
+ * @struct FunctionDecl
+ * @brief A function, kind SYNTAX_FUNCTION_DECL, or a procedure, kind
+ *        SYNTAX_PROCEDURE_DECL, whose returnType is VOID
+ * @remark parameters is nullptr for (void)
+ */
+struct FunctionDecl : Stmt {
+    TokenType returnType;
+    string_view name;
+    SymbolId symbol;
+    Variable* parameters;
+    BlockStmt* body;
+};
+
+/**
+ * @struct IfStmt
+ * @brief if, with otherwise nullptr when there is no else
+ */
+struct IfStmt : Stmt {
+    Expr* condition;
+    Stmt* then;
+    Stmt* otherwise;
+};
+
+/**
+ * @struct ForStmt
+ * @brief for, with each of its three parts nullptr when left out
+ */
+struct ForStmt : Stmt {
+    Stmt* init;
+    Expr* condition;
+    Stmt* step;
+    Stmt* body;
+};
+
+/**
+ * @struct WhileStmt
+ * @brief while
+ */
+struct WhileStmt : Stmt {
+    Expr* condition;
+    Stmt* body;
+};
+
+/**
+ * @struct ReturnStmt
+ * @brief return, with value nullptr when nothing is returned
+ */
+struct ReturnStmt : Stmt {
+    Expr* value;
+};
+
+/**
+ * @struct AssignStmt
+ * @brief target = value, where target is a NameExpr or an IndexExpr
+ */
+struct AssignStmt : Stmt {
+    Expr* target;
+    Expr* value;
+};
+
+/**
+ * @struct CallStmt
+ * @brief A call of a procedure, or of a function whose result is not used
+ */
+struct CallStmt : Stmt {
+    CallExpr* call;
+};
+
+/**
+ * @struct PrintfStmt
+ * @brief printf, with the values for its format chained through Expr::next
+ */
+struct PrintfStmt : Stmt {
+    StringExpr* format;
+    Expr* arguments;
+};
+
+/**
+ * @brief Returns the characters of an operator, for printing
+ * @param op - The type of an operator token
+ */
+const char* getOperatorText(TokenType op);
+
+/**
+ * @brief Writes a syntax tree with one node on each line, indented by depth
+ * @param os - The output stream
+ * @param program - The first top-level declaration, or nullptr
+ * @returns The modified output stream
+ * @remark Outputs lines like
+ *
+ *      ForStmt
+ *        AssignStmt
+ *          NameExpr i
+ *          IntegerExpr 0
+ */
+ostream& printSyntaxTree(ostream& os, const Stmt* program);
+
+#endif
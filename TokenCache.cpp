@@ -0,0 +1,213 @@
+/**
+ * @file TokenCache.cpp
+ * @brief Implementation file for the token cache format
+ * @authors Jacob Franco, Zach Gassner, Haley Joerger, Adam Lyday
+ */
+
+#include "TokenCache.hpp"
+#include "IdentifierTable.hpp"
+#include <cstring>
+#include <string>
+#include <unordered_map>
+
+/**
+ * @brief The number of magic bytes, without the '\0' of the literal
+ */
+static const size_t TOKEN_CACHE_MAGIC_SIZE = sizeof(TOKEN_CACHE_MAGIC) - 1;
+
+/**
+ * @brief Appends a number to out as an unsigned LEB128 varint
+ * @param out - The bytes written so far
+ * @param value - The number
+ * @remark Seven bits per byte, low bits first, with the top bit set on every
+ *         byte but the last
+ */
+static void writeVarint(string& out, uint64_t value) {
+    while (value >= 0x80) {
+        out += char(value | 0x80);
+        value >>= 7;
+    }
+
+    out += char(value);
+}
+
+/**
+ * @brief Returns true if data starts like a token cache
+ * @param data - The first byte of a file
+ * @param size - The number of bytes in the file
+ */
+bool isTokenCache(const char* data, size_t size) {
+    return size > TOKEN_CACHE_MAGIC_SIZE && 
+           memcmp(data, TOKEN_CACHE_MAGIC, TOKEN_CACHE_MAGIC_SIZE) == 0;
+}
+
+/**
+ * @brief Writes every token of a program as a token cache
+ * @param os - The stream the cache is written to, opened in binary mode
+ * @param tokens - The tokens of a program that lexed without errors
+ */
+void writeTokenCache(ostream& os, const TokenStream& tokens) {
+    unordered_map<string_view, uint64_t> numbers;
+    vector<string_view> strings;
+    vector<uint64_t> stringOfToken(tokens.size());
+
+    for (size_t i = 0; i < tokens.size(); i++) {
+        auto found = numbers.emplace(tokens.text(i), strings.size());
+
+        if (found.second)
+            strings.push_back(tokens.text(i));
+
+        stringOfToken[i] = found.first->second;
+    }
+
+    // the whole cache is put together in memory so the stream is written 
+    // once
+    string out(TOKEN_CACHE_MAGIC, TOKEN_CACHE_MAGIC_SIZE);
+    out += char(TOKEN_CACHE_VERSION);
+    writeVarint(out, strings.size());
+
+    for (string_view text : strings) {
+        writeVarint(out, text.size());
+        out.append(text.data(), text.size());
+    }
+
+    writeVarint(out, tokens.size());
+    uint64_t line = 1;
+    uint64_t offset = 0;
+
+    for (size_t i = 0; i < tokens.size(); i++) {
+        out += char(tokens.type(i));
+        writeVarint(out, tokens.getLineNumber(i) - line);
+        writeVarint(out, tokens.offset(i) - offset);
+        writeVarint(out, stringOfToken[i]);
+        line = tokens.getLineNumber(i);
+        offset = tokens.offset(i);
+    }
+
+    os.write(out.data(), out.size());
+}
+
+/**
+ * @brief Constructor
+ * @param data - The first byte of a token cache
+ * @param size - The number of bytes in the cache
+ * @remark Reads the string table; the tokens are read by next()
+ */
+TokenCacheReader::TokenCacheReader(const char* data, size_t size) 
+    : data(data), length(size), position(TOKEN_CACHE_MAGIC_SIZE + 1), 
+      remaining(0), offset(0), failed(false) {
+    uint64_t count;
+
+    if (!isTokenCache(data, size) || 
+        uint8_t(data[TOKEN_CACHE_MAGIC_SIZE]) != TOKEN_CACHE_VERSION ||
+        !readVarint(count) || count > length - position) {
+        failed = true;
+        return;
+    }
+
+    strings.reserve(count);
+
+    for (uint64_t i = 0; i < count; i++) {
+        uint64_t size;
+
+        if (!readVarint(size) || size > length - position) {
+            failed = true;
+            return;
+        }
+
+        strings.emplace_back(data + position, size);
+        position += size;
+    }
+
+    // words are interned the first time a token uses them
+    symbols.assign(count, NO_SYMBOL);
+
+    if (!readVarint(remaining))
+        failed = true;
+}
+
+/**
+ * @brief Moves the next token into token
+ * @param token - Receives the next token
+ * @returns False once every token has been returned, or the cache turns out
+ *          to be damaged
+ */
+bool TokenCacheReader::next(Token& token) {
+    if (failed || remaining == 0)
+        return false;
+
+    uint64_t lineDelta, offsetDelta, text;
+
+    if (position == length) {
+        failed = true;
+        return false;
+    }
+
+    uint8_t type = data[position++];
+
+    // each new line needs a newline between the two tokens, so a cache that
+    // claims more lines than characters is damaged, and cannot make the 
+    // line index grow past the size of the program
+    if (type > KEYWORD_PRINTF || !readVarint(lineDelta) || 
+        !readVarint(offsetDelta) || !readVarint(text) || 
+        text >= strings.size() || offsetDelta > UINT32_MAX - offset ||
+        lineDelta > offsetDelta) {
+        failed = true;
+        return false;
+    }
+
+    // every line up to the token's starts no later than the token, and 
+    // every line after it starts after it, which is all getLineNumber needs
+    lineIndex.addLineStarts(offset + offsetDelta, lineDelta);
+
+    offset += offsetDelta;
+    remaining--;
+
+    token.type = TokenType(type);
+    token.character = strings[text];
+    token.offset = offset;
+    token.symbol = NO_SYMBOL;
+
+    if (isWord(token.type)) {
+        if (symbols[text] == NO_SYMBOL)
+            symbols[text] = IdentifierTable::get().intern(strings[text]);
+
+        token.symbol = symbols[text];
+    }
+
+    return true;
+}
+
+/**
+ * @brief Returns true if the cache is damaged or cut short
+ */
+bool TokenCacheReader::hasError() const {
+    return failed;
+}
+
+/**
+ * @brief Getter for lineIndex private variable
+ * @returns A line index that gives every token read so far its line
+ */
+const LineIndex& TokenCacheReader::getLineIndex() const {
+    return lineIndex;
+}
+
+/**
+ * @brief Reads a varint at position
+ * @param value - Receives the number
+ * @returns False if the cache ends in the middle of it
+ */
+bool TokenCacheReader::readVarint(uint64_t& value) {
+    value = 0;
+
+    for (int shift = 0; shift < 64 && position < length; shift += 7) {
+        uint8_t byte = data[position++];
+        value |= uint64_t(byte & 0x7F) << shift;
+
+        if ((byte & 0x80) == 0)
+            return true;
+    }
+
+    return false;
+}
@@ -0,0 +1,149 @@
+/**
+ * @file TokenCache.hpp
+ * @brief Defines the binary format tokens are cached in, so that a program 
+ *        can be parsed again without stripping comments or lexing it
+ * @authors Jacob Franco, Zach Gassner, Haley Joerger, Adam Lyday
+ */
+
+#ifndef TOKEN_CACHE_HPP
+#define TOKEN_CACHE_HPP
+
+#include "Tokenization.hpp"
+#include "LineIndex.hpp"
+#include <cstdint>
+#include <iostream>
+#include <string_view>
+#include <vector>
+
+using namespace std;
+
+/**
+ * @brief The first bytes of every token cache
+ * @remark 0xFF is never part of valid UTF-8, so no program the lexer accepts
+ *         can start with them
+ */
+const char TOKEN_CACHE_MAGIC[] = "\xffTOK";
+
+/**
+ * @brief The version of the format, written right after the magic bytes
+ */
+const uint8_t TOKEN_CACHE_VERSION = 1;
+
+/**
+ * @brief Returns true if data starts like a token cache
+ * @param data - The first byte of a file
+ * @param size - The number of bytes in the file
+ */
+bool isTokenCache(const char* data, size_t size);
+
+/**
+ * @brief Writes every token of a program as a token cache
+ * @param os - The stream the cache is written to, opened in binary mode
+ * @param tokens - The tokens of a program that lexed without errors
+ * @remark The format, with every number an unsigned LEB128 varint:
+ *
+ *      magic, version byte
+ *      string count, then the length and bytes of every distinct token text
+ *      token count, then for every token:
+ *          type byte, line delta, offset delta, string number
+ *
+ *         Line numbers and offsets are stored as the difference from the 
+ *         token before, so most tokens take 4 bytes.
+ */
+void writeTokenCache(ostream& os, const TokenStream& tokens);
+
+/**
+ * @class TokenCacheReader
+ * @brief Reads the tokens back out of a token cache one at a time, without
+ *        copying their text
+ * @remark The text of each token points into the cache, so the cache has to
+ *         outlive the tokens. The words are interned once per distinct text,
+ *         not once per token. A damaged or cut short cache stops the reader
+ *         instead of being read past its end.
+ */
+class TokenCacheReader {
+public:
+    /**
+     * @brief Constructor
+     * @param data - The first byte of a token cache
+     * @param size - The number of bytes in the cache
+     * @remark Reads the string table; the tokens are read by next()
+     */
+    TokenCacheReader(const char* data, size_t size);
+
+    /**
+     * @brief Moves the next token into token
+     * @param token - Receives the next token
+     * @returns False once every token has been returned, or the cache turns
+     *          out to be damaged
+     */
+    bool next(Token& token);
+
+    /**
+     * @brief Returns true if the cache is damaged or cut short
+     */
+    bool hasError() const;
+
+    /**
+     * @brief Getter for lineIndex private variable
+     * @returns A line index that gives every token read so far its line
+     * @remark Only the starts of lines that have tokens are known, which is
+     *         all that looking up the line of a token needs
+     */
+    const LineIndex& getLineIndex() const;
+
+private:
+    /**
+     * @brief Reads a varint at position
+     * @param value - Receives the number
+     * @returns False if the cache ends in the middle of it
+     */
+    bool readVarint(uint64_t& value);
+
+    /**
+     * @brief The bytes of the cache
+     */
+    const char* data;
+
+    /**
+     * @brief The number of bytes in the cache
+     */
+    size_t length;
+
+    /**
+     * @brief The index of the next byte to read
+     */
+    size_t position;
+
+    /**
+     * @brief Every distinct token text, pointing into the cache
+     */
+    vector<string_view> strings;
+
+    /**
+     * @brief The IdentifierTable number of every string
+     */
+    vector<SymbolId> symbols;
+
+    /**
+     * @brief The number of tokens not read yet
+     */
+    uint64_t remaining;
+
+    /**
+     * @brief The offset of the last token read
+     */
+    uint64_t offset;
+
+    /**
+     * @brief Line starts of the program the tokens were lexed from
+     */
+    LineIndex lineIndex;
+
+    /**
+     * @brief True once the cache turned out to be damaged
+     */
+    bool failed;
+};
+
+#endif
@@ -5,343 +5,1072 @@
  */
 
 #include "Tokenization.hpp"
+#include "CharClass.hpp"
+#include <array>
+#include <cstring>
+#include <memory>
+#include <thread>
 
 /**
- * @brief Constructor
- * @param input - A string representing a C-style program 
- * @remark Constructs Tokenization object by tokenizing the input program and
- *          storing tokens in private variable
+ * @struct Keyword
+ * @brief A reserved word and the token type the lexer gives it
  */
-Tokenization::Tokenization(const string& input) {
-    string currentToken; //Read char by char
-    bool inComment = false;
-    bool inString = false;
-    int lineNumber = 1;
+struct Keyword {
+    string_view text;
+    TokenType type = IDENTIFIER;
+};
 
-    for (size_t i = 0; i < input.size(); ++i) {
+/**
+ * @brief Every reserved word
+ */
+static constexpr Keyword KEYWORDS[] = {
+    {"int", KEYWORD_INT},
+    {"char", CHAR},
+    {"bool", KEYWORD_BOOL},
+    {"string", KEYWORD_STRING},
+    {"void", VOID},
+    {"function", KEYWORD_FUNCTION},
+    {"procedure", KEYWORD_PROCEDURE},
+    {"if", KEYWORD_IF},
+    {"else", KEYWORD_ELSE},
+    {"for", KEYWORD_FOR},
+    {"while", KEYWORD_WHILE},
+    {"return", KEYWORD_RETURN},
+    {"printf", KEYWORD_PRINTF},
+    {"TRUE", BOOLEAN_TRUE},
+    {"FALSE", BOOLEAN_FALSE},
+};
 
-        if (inString) {
-            Token stringToken;
-            stringToken.type = STRING;
-            stringToken.lineNumber = lineNumber;
+/**
+ * @brief The number of slots in the keyword hash table; a power of two
+ */
+static constexpr size_t KEYWORD_TABLE_SIZE = 32;
 
-            while (input[i] != tokens.back().character[0]) {
-                stringToken.character += input[i++];
-            }
+/**
+ * @brief Hashes a word from its first and last characters and its length
+ * @param word - A word of at least one character
+ * @param seed - The multiplier found by findKeywordSeed
+ */
+static constexpr size_t hashKeyword(string_view word, size_t seed) {
+    return (static_cast<unsigned char>(word[0]) * seed + 
+            static_cast<unsigned char>(word[word.size() - 1]) + 
+            word.size()) & (KEYWORD_TABLE_SIZE - 1);
+}
 
-            tokens.push_back(stringToken);    
+/**
+ * @brief Finds a seed that gives every keyword its own slot
+ * @returns The seed, or 0 if there is none
+ */
+static constexpr size_t findKeywordSeed() {
+    for (size_t seed = 1; seed < 1024; seed++) {
+        bool used[KEYWORD_TABLE_SIZE] = {};
+        bool perfect = true;
+
+        for (const Keyword& keyword : KEYWORDS) {
+            size_t slot = hashKeyword(keyword.text, seed);
+            perfect = perfect && !used[slot];
+            used[slot] = true;
         }
 
-        char nextChar = i + 1 < input.size() ? input[i + 1] : 0; 
-        Token inputToken;
+        if (perfect)
+            return seed;
+    }
 
-        switch(input[i]) {
-            case ' ':
-                break;
+    return 0;
+}
 
-            case '\n':
-                lineNumber++;
-                break;
+static constexpr size_t KEYWORD_SEED = findKeywordSeed();
+static_assert(KEYWORD_SEED != 0, "no perfect hash for the keywords");
 
-            case '(':
-                inputToken.type = LEFT_PARENTHESIS;
-                inputToken.character = "(";
-                inputToken.lineNumber = lineNumber;
-                tokens.push_back(inputToken);
-                break;
-                
-            case ')':
-                inputToken.type = RIGHT_PARENTHESIS;
-                inputToken.character = ")";
-                inputToken.lineNumber = lineNumber;
-                tokens.push_back(inputToken);
-                break;
+/**
+ * @brief Places every keyword in its slot
+ * @returns The table; empty slots hold an empty word
+ */
+static constexpr array<Keyword, KEYWORD_TABLE_SIZE> makeKeywordTable() {
+    array<Keyword, KEYWORD_TABLE_SIZE> table = {};
 
-            case '[':
-                inputToken.type = LEFT_BRACKET;
-                inputToken.character = "[";
-                inputToken.lineNumber = lineNumber;
+    for (const Keyword& keyword : KEYWORDS)
+        table[hashKeyword(keyword.text, KEYWORD_SEED)] = keyword;
 
-                // Check if the next character is a '-' to indicate a negative array size
-                if (input[i + 1] == '-') {
-                    std::cerr << "Syntax error on line " << lineNumber << ": array declaration size must be a positive integer.\n";
-                    exit(EXIT_FAILURE); // Or handle the error as needed
-                }
+    return table;
+}
 
-                tokens.push_back(inputToken);
-                break;
+/**
+ * @brief The keywords, built at compile time so that every keyword is found
+ *        with one hash and one comparison
+ */
+static constexpr array<Keyword, KEYWORD_TABLE_SIZE> KEYWORD_TABLE = 
+    makeKeywordTable();
 
-            case ']':
-                inputToken.type = RIGHT_BRACKET;
-                inputToken.character = "]";
-                inputToken.lineNumber = lineNumber;
-                tokens.push_back(inputToken);
-                break;
+/**
+ * @brief Returns the token type of a word
+ * @param word - The characters of an identifier
+ * @returns The keyword's type if word is reserved, otherwise IDENTIFIER
+ */
+static TokenType keywordType(string_view word) {
+    // "if" is the shortest keyword and "procedure" the longest
+    if (word.size() < 2 || word.size() > 9)
+        return IDENTIFIER;
 
-            case '{':
-                inputToken.type = LEFT_BRACE;
-                inputToken.character = "{";
-                inputToken.lineNumber = lineNumber;
-                tokens.push_back(inputToken);
-                break;
+    const Keyword& keyword = KEYWORD_TABLE[hashKeyword(word, KEYWORD_SEED)];
+    return keyword.text == word ? keyword.type : IDENTIFIER;
+}
 
-            case '}':
-                inputToken.type = RIGHT_BRACE;
-                inputToken.character = "}";
-                inputToken.lineNumber = lineNumber;
-                tokens.push_back(inputToken);
-                break;
+/**
+ * @struct Operator
+ * @brief The characters of an operator or punctuation mark and the token type
+ *        the lexer gives it
+ */
+struct Operator {
+    string_view text;
+    TokenType type;
+};
 
-            case '"':
-                inputToken.type = DOUBLE_QUOTE;
-                inputToken.character = "\"";
-                inputToken.lineNumber = lineNumber;
+/**
+ * @brief Every operator and punctuation mark; the lexer always takes the 
+ *        longest one that matches
+ * @remark Quotes and the '-' of a negative integer are lexed separately
+ */
+static constexpr Operator OPERATORS[] = {
+    {"(", LEFT_PARENTHESIS},
+    {")", RIGHT_PARENTHESIS},
+    {"[", LEFT_BRACKET},
+    {"]", RIGHT_BRACKET},
+    {"{", LEFT_BRACE},
+    {"}", RIGHT_BRACE},
+    {";", SEMICOLON},
+    {",", COMMA},
+    {"=", ASSIGNMENT},
+    {"+", PLUS},
+    {"-", MINUS},
+    {"/", DIVIDE},
+    {"*", ASTERISK},
+    {"%", MODULO},
+    {"^", CARAT},
+    {"<", LT},
+    {">", GT},
+    {"<=", LT_EQUAL},
+    {">=", GT_EQUAL},
+    {"&&", BOOLEAN_AND_OPERATOR},
+    {"||", BOOLEAN_OR_OPERATOR},
+    {"!", BOOLEAN_NOT_OPERATOR},
+    {"==", BOOLEAN_EQUAL},
+    {"!=", BOOLEAN_NOT_EQUAL},
+};
 
-                if(input[i+1]=='\n' || input[i-1] == '\\'){
-                    std::cerr << "Syntax error on line " << lineNumber << ": unterminated string quote." << endl;
-                    exit(EXIT_FAILURE);
-                }
+/**
+ * @struct OperatorTable
+ * @brief A DFA that recognizes the operators
+ * @tparam STATES - The most states the DFA can need
+ * @tparam COLUMNS - The number of different operator characters, plus one
+ * @remark State 0 is the start state. No transition leads back to it, so
+ *         reaching it again means no longer operator matches.
+ */
+template <size_t STATES, size_t COLUMNS>
+struct OperatorTable {
+    /**
+     * @brief The column of every character; 0 for characters that are in no
+     *        operator
+     */
+    array<uint8_t, 256> columns = {};
+
+    /**
+     * @brief The state to go to from a state on a column
+     */
+    array<array<uint8_t, COLUMNS>, STATES> transitions = {};
+
+    /**
+     * @brief True if the characters read to reach a state are an operator
+     */
+    array<bool, STATES> accepting = {};
+
+    /**
+     * @brief The operator's type, for accepting states
+     */
+    array<TokenType, STATES> types = {};
+};
 
-                tokens.push_back(inputToken);
-                inString = !inString;
-                break;
+/**
+ * @brief Returns the most states the operator DFA can need: one for the 
+ *        start, plus one for every operator character
+ */
+static constexpr size_t countOperatorStates() {
+    size_t states = 1;
 
-            case '\'':
-                inputToken.type = SINGLE_QUOTE;
-                inputToken.character = "\'";
-                inputToken.lineNumber = lineNumber;
-                tokens.push_back(inputToken);
-                inString = !inString;
-                break;
+    for (const Operator& op : OPERATORS)
+        states += op.text.size();
 
-            case ';':
-                inputToken.type = SEMICOLON;
-                inputToken.character = ";";
-                inputToken.lineNumber = lineNumber;
-                tokens.push_back(inputToken);
-                break;
-            
-            case ',':
-                inputToken.type = COMMA;
-                inputToken.character = ",";
-                inputToken.lineNumber = lineNumber;
-                tokens.push_back(inputToken);
-                break;
+    return states;
+}
 
-            case '=':
-                if (nextChar == '=') {
-                    inputToken.type = BOOLEAN_EQUAL;
-                    inputToken.character = "==";
-                    inputToken.lineNumber = lineNumber;
-                    tokens.push_back(inputToken);
-                    i++;
-                } else {
-                    inputToken.type = ASSIGNMENT;
-                    inputToken.character = "=";
-                    inputToken.lineNumber = lineNumber;
-                    tokens.push_back(inputToken);
-                }
-                
-                break;
+/**
+ * @brief Returns the number of different characters in the operators, plus
+ *        one for the column of every other character
+ */
+static constexpr size_t countOperatorColumns() {
+    bool seen[256] = {};
+    size_t columns = 1;
+
+    for (const Operator& op : OPERATORS) {
+        for (char c : op.text) {
+            columns += !seen[static_cast<unsigned char>(c)];
+            seen[static_cast<unsigned char>(c)] = true;
+        }
+    }
 
-            case '+':
-                inputToken.type = PLUS;
-                inputToken.character = "+";
-                inputToken.lineNumber = lineNumber;
-                tokens.push_back(inputToken);
-                break;
+    return columns;
+}
 
-            case '-':
-                if (isdigit(nextChar)) {
-                    i++;
-                    inputToken.type = INTEGER;
-                    inputToken.character = '-';
-                    inputToken.lineNumber = lineNumber;
-                    
-                    while (isdigit(input[i])) {
-                        inputToken.character += input[i++];
-                    }
+using OperatorDFA = OperatorTable<countOperatorStates(), 
+                                  countOperatorColumns()>;
 
-                    i--;
-                    tokens.push_back(inputToken);
-                } else {
-                    inputToken.type = MINUS;
-                    inputToken.character = "-";
-                    inputToken.lineNumber = lineNumber;
-                    tokens.push_back(inputToken);
-                }
-            
-                break;
+/**
+ * @brief Builds the operator DFA at compile time, as a trie of OPERATORS
+ */
+static constexpr OperatorDFA makeOperatorTable() {
+    OperatorDFA table;
+    size_t columns = 1;
+    size_t states = 1;
 
-            case '/':
-                inputToken.type = DIVIDE;
-                inputToken.character = "/";
-                inputToken.lineNumber = lineNumber;
-                tokens.push_back(inputToken);
-                break;
+    for (const Operator& op : OPERATORS) {
+        size_t state = 0;
 
-            case '*':
-                inputToken.type = ASTERISK;
-                inputToken.character = "*";
-                inputToken.lineNumber = lineNumber;
-                tokens.push_back(inputToken);
-                break;
+        for (char c : op.text) {
+            uint8_t& column = table.columns[static_cast<unsigned char>(c)];
 
-            case '%':
-                inputToken.type = MODULO;
-                inputToken.character = "%";
-                inputToken.lineNumber = lineNumber;
-                tokens.push_back(inputToken);
-                break;
+            if (column == 0)
+                column = columns++;
 
-            case '^':
-                inputToken.type = CARAT;
-                inputToken.character = "^";
-                inputToken.lineNumber = lineNumber;
-                tokens.push_back(inputToken);
-                break;
-            
-            case '<':
-                if (nextChar == '=') {
-                    inputToken.type = LT_EQUAL;
-                    inputToken.character = "<=";
-                    inputToken.lineNumber = lineNumber;
-                    tokens.push_back(inputToken);
-                    i++;
-                } else {
-                    inputToken.type = LT;
-                    inputToken.character = "<";
-                    inputToken.lineNumber = lineNumber;
-                    tokens.push_back(inputToken);
-                }
+            uint8_t& next = table.transitions[state][column];
+
+            if (next == 0)
+                next = states++;
+
+            state = next;
+        }
+
+        table.accepting[state] = true;
+        table.types[state] = op.type;
+    }
+
+    return table;
+}
+
+/**
+ * @brief The operator DFA, shared by every lexer
+ */
+static constexpr OperatorDFA OPERATOR_TABLE = makeOperatorTable();
+
+/**
+ * @brief Returns true if some operator starts with c
+ */
+static bool startsOperator(char c) {
+    uint8_t column = OPERATOR_TABLE.columns[static_cast<unsigned char>(c)];
+    return OPERATOR_TABLE.transitions[0][column] != 0;
+}
+
+/**
+ * @brief Finds the longest operator that starts at index i
+ * @param input - The program being tokenized
+ * @param i - The index to match at
+ * @param type - Receives the operator's type
+ * @returns The number of characters in the operator, or 0 if none matches
+ */
+static size_t matchOperator(const LexerInput& input, size_t i, 
+                            TokenType& type) {
+    size_t length = 0;
+    size_t state = 0;
+
+    for (size_t j = i; ; j++) {
+        uint8_t column = 
+            OPERATOR_TABLE.columns[static_cast<unsigned char>(input[j])];
+        state = OPERATOR_TABLE.transitions[state][column];
+
+        if (state == 0)
+            return length;
+
+        if (OPERATOR_TABLE.accepting[state]) {
+            type = OPERATOR_TABLE.types[state];
+            length = j - i + 1;
+        }
+    }
+}
+
+/**
+ * @brief Returns true if a line or block comment starts at index i
+ * @param input - The program being tokenized
+ * @param i - The index to check
+ */
+static bool startsComment(const LexerInput& input, size_t i) {
+    return input[i] == '/' && (input[i + 1] == '/' || input[i + 1] == '*');
+}
+
+/**
+ * @brief Skips the comment that starts at index i
+ * @param input - The program being tokenized
+ * @param i - The index of the '/' that starts the comment
+ * @returns The index of the comment's last character; for '//' comments the
+ *          newline is left for the caller
+ * @remark A block comment that runs off the end returns input.size() - 1 
+ *          and sets unterminated
+ */
+static size_t skipComment(const LexerInput& input, size_t i, 
+                          bool& unterminated) {
+    if (input[i + 1] == '/') {
+        i += 2;
+
+        while (i < input.size() && input[i] != '\n')
+            i++;
+
+        return i - 1;
+    }
+
+    for (i += 2; i < input.size(); i++) {
+        if (input[i] == '*' && input[i + 1] == '/')
+            return i + 1;
+    }
+
+    unterminated = true;
+    return input.size() - 1;
+}
+
+/**
+ * @brief Constructor
+ * @remark Lexes an empty program until reset is called
+ */
+Lexer::Lexer() 
+    : input{ "", 0 }, skipComments(false), position(0), inString(false), 
+      quote('\0'), restarted(false), first(0), end(0), chunked(false), 
+      failed(false) { }
+
+/**
+ * @brief Constructor
+ * @param input - A string representing a C-style program without comments
+ */
+Lexer::Lexer(const string& input) 
+    : input{ input.data(), input.size() }, skipComments(false), position(0),
+      inString(false), quote('\0'), restarted(false),
+      lineIndex(input.data(), min(input.size(), MAX_PROGRAM_SIZE)), first(0), 
+      end(input.size()), chunked(false), failed(false) {
+    rejectTooLarge();
+}
+
+/**
+ * @brief Constructor
+ * @param stripped - A C-style program that has been through IgnoreComments
+ * @remark Reuses the line index IgnoreComments built while stripping
+ */
+Lexer::Lexer(const IgnoreComments& stripped) 
+    : input{ stripped.getResult().data(), stripped.getResult().size() }, 
+      skipComments(false), position(0), inString(false), quote('\0'), 
+      restarted(false), lineIndex(stripped.getLineIndex()), first(0), 
+      end(stripped.getResult().size()), chunked(false), failed(false) {
+    rejectTooLarge();
+}
+
+/**
+ * @brief Constructor
+ * @param source - A C-style program that may still contain comments
+ * @remark Fused mode: comments are skipped while tokenizing, so no
+ *          comment-free copy of the program is ever made. Produces the same
+ *          tokens as running the program through IgnoreComments first,
+ *          including its unterminated comment error. A program that is not
+ *          valid UTF-8 is rejected before any token is produced.
+ */
+Lexer::Lexer(const SourceBuffer& source) : Lexer() {
+    reset(source);
+}
+
+/**
+ * @brief Starts over on another program, keeping the memory of the pending
+ *        tokens and the line index
+ * @param source - A C-style program that may still contain comments
+ */
+void Lexer::reset(const SourceBuffer& source) {
+    input = LexerInput{ source.data(), source.size() };
+    skipComments = true;
+    position = 0;
+    inString = false;
+    quote = '\0';
+    restarted = false;
+    replacement.clear();
+    pending.clear();
+    first = 0;
+    end = source.size();
+    failed = false;
+
+    if (rejectTooLarge()) {
+        lineIndex.build(source.data(), 0);
+        return;
+    }
+
+    lineIndex.build(source.data(), source.size());
+
+    // the encoding was checked while loading, so from here on any byte past
+    // 0x7F is part of a valid character in an identifier or string
+    if (source.getInvalidUtf8Offset() < source.size()) {
+        syntaxError(DIAGNOSTIC_INVALID_UTF8, source.getInvalidUtf8Offset(),
+                    "invalid UTF-8 encoding.");
+    }
+}
+
+/**
+ * @brief Constructor for lexing one chunk of a program
+ * @param whole - A lexer for the whole program that has not started yet
+ * @param begin - The index to start lexing at
+ * @param end - Tokens that start at or after end are left for the next 
+ *              chunk
+ * @param inString - True if begin is inside a string or character literal
+ * @param quote - The quote that opened that literal
+ * @remark Syntax errors, and anything IgnoreComments might reject, stop the
+ *         lexer instead of being reported, since the chunk may have been 
+ *         started in the wrong state. There is no line index, since nothing
+ *         is reported.
+ */
+Lexer::Lexer(const Lexer& whole, size_t begin, size_t end, bool inString, 
+             char quote)
+    : input(whole.input), skipComments(whole.skipComments), position(begin),
+      inString(inString), quote(quote), restarted(false), first(0), end(end),
+      chunked(true), failed(false) { }
+
+/**
+ * @brief Moves the next token into token
+ * @param token - Receives the next token
+ * @returns False once every token has been returned
+ */
+bool Lexer::next(Token& token) {
+    if (!fill(0))
+        return false;
+
+    token = pending[first++];
+
+    // once everything pending is taken, start over at the front so the 
+    // buffer is reused instead of growing
+    if (first == pending.size()) {
+        pending.clear();
+        first = 0;
+    }
+
+    return true;
+}
+
+/**
+ * @brief Looks at a token without consuming it
+ * @param k - How many tokens ahead to look; 0 is the token next() returns
+ * @returns The token, or nullptr if the program has fewer tokens left
+ */
+const Token* Lexer::peek(size_t k) {
+    return fill(k) ? &pending[first + k] : nullptr;
+}
+
+/**
+ * @brief Getter for lineIndex private variable
+ * @returns The line index for the offsets stored in the tokens
+ */
+const LineIndex& Lexer::getLineIndex() const {
+    return lineIndex;
+}
+
+/**
+ * @brief Returns true if the lexer restarted on IgnoreComments' error
+ *        message; tokens returned before that are not part of the program
+ */
+bool Lexer::hasRestarted() const {
+    return restarted;
+}
+
+/**
+ * @brief Returns true if the lexer stopped on a syntax error; next() returns
+ *        false from then on
+ */
+bool Lexer::hasError() const {
+    return failed;
+}
+
+/**
+ * @brief Getter for diagnostic private variable
+ * @returns The syntax error the lexer stopped on
+ */
+const Diagnostic& Lexer::getDiagnostic() const {
+    return diagnostic;
+}
+
+/**
+ * @brief Returns the characters being tokenized, which the offsets of the
+ *        tokens are relative to
+ * @remark Changes when the lexer restarts
+ */
+string_view Lexer::getProgram() const {
+    return input.slice(0, input.size());
+}
+
+/**
+ * @brief Lexes until more than k tokens are pending or the input runs out
+ * @param k - The index of the pending token that is needed
+ * @returns True if the k-th token not taken yet exists
+ */
+bool Lexer::fill(size_t k) {
+    while (pending.size() - first <= k && position < end && !failed)
+        step();
+
+    return pending.size() - first > k;
+}
+
+/**
+ * @brief Lexes every token that starts before end into pending
+ */
+void Lexer::lexChunk() {
+    while (position < end && !failed)
+        step();
+}
+
+/**
+ * @brief Stops the lexer on a syntax error, keeping it in diagnostic
+ * @param code - Which error it is
+ * @param offset - Where in input the error is
+ * @param message - What is wrong
+ * @remark The caller returns right after, and nothing is lexed from then 
+ *         on. A chunk lexer only marks itself failed.
+ */
+void Lexer::syntaxError(DiagnosticCode code, size_t offset, 
+                        const string& message) {
+    failed = true;
+
+    if (!chunked)
+        diagnostic = Diagnostic{code, lineIndex.getLineNumber(offset), message};
+}
+
+/**
+ * @brief Stops the lexer before it starts if the program is larger than 
+ *        MAX_PROGRAM_SIZE
+ * @returns True if it did
+ * @remark Its offsets would wrap, so the error is not on any line
+ */
+bool Lexer::rejectTooLarge() {
+    if (input.size() <= MAX_PROGRAM_SIZE)
+        return false;
+
+    failed = true;
+    diagnostic = Diagnostic{DIAGNOSTIC_PROGRAM_TOO_LARGE, 0, 
+                            "the program is too large."};
+    return true;
+}
+
+/**
+ * @brief Checks whether IgnoreComments would have rejected the program
+ * @returns True if it would, in which case the lexer starts over on
+ *          IgnoreComments' error message, as the two pass pipeline did
+ * @remark Only does anything in fused mode, where it is called when the 
+ *          lexer runs into something suspicious (a stray '*' '/', an 
+ *          unterminated comment or an error of its own). Running the real 
+ *          DFA here keeps the error and its line number identical to the 
+ *          two pass pipeline.
+ */
+bool Lexer::replaceWithCommentError() {
+    if (!skipComments)
+        return false;
+
+    // the serial lexer works out what IgnoreComments would have said
+    if (chunked) {
+        failed = true;
+        return true;
+    }
+
+    IgnoreComments stripped(input.data, input.length);
+
+    if (!stripped.hasError())
+        return false;
+
+    replacement = stripped.getResult();
+    input = LexerInput{ replacement.data(), replacement.size() };
+    end = input.size();
+    lineIndex = stripped.getLineIndex();
+    skipComments = false;
+    position = 0;
+    inString = false;
+    restarted = true;
+    pending.clear();
+    first = 0;
+    return true;
+}
+
+/**
+ * @brief Lexes the operator that starts at index i, adding it to pending
+ * @param i - The index of the operator's first character; moved to its last
+ * @returns False if the lexer restarted on IgnoreComments' error or stopped
+ *          on a syntax error instead
+ * @remark A '&' or '|' on its own is not an operator, and is an invalid
+ *         character
+ */
+bool Lexer::lexOperator(size_t& i) {
+    Token inputToken;
+    inputToken.offset = i;
+    size_t length = matchOperator(input, i, inputToken.type);
+
+    if (length == 0) {
+        if (replaceWithCommentError())
+            return false;
+
+        syntaxError(DIAGNOSTIC_INVALID_CHARACTER, i, 
+                    "invalid character '" + string(1, input[i]) + "'.");
+        return false;
+    }
+
+    // '*' '/' outside a comment puts IgnoreComments' DFA in ERROR
+    if (inputToken.type == ASTERISK && input[i + 1] == '/' && 
+        replaceWithCommentError())
+        return false;
+
+    // Check if the next character is a '-' to indicate a negative array size
+    if (inputToken.type == LEFT_BRACKET && input[i + 1] == '-') {
+        if (replaceWithCommentError())
+            return false;
+
+        syntaxError(DIAGNOSTIC_NEGATIVE_ARRAY_SIZE, i, 
+                    "array declaration size must be a positive integer.");
+        return false;
+    }
+
+    inputToken.character = input.slice(i, i + length);
+    pending.push_back(inputToken);
+    i += length - 1;
+    return true;
+}
+
+/**
+ * @brief Lexes the characters at position, adding any tokens they finish
+ *        to pending
+ * @remark One call handles one character, or one whole token or comment
+ *          that starts there
+ */
+void Lexer::step() {
+    size_t i = position;
+
+    if (inString) {
+        Token stringToken;
+        stringToken.type = STRING;
+        stringToken.offset = i;
+
+        while (i < input.size() && input[i] != quote) {
+            i++;
+        }
+
+        stringToken.character = input.slice(stringToken.offset, i);
+
+        pending.push_back(stringToken);    
+    }
+
+    if (skipComments && startsComment(input, i)) {
+        bool unterminated = false;
+        i = skipComment(input, i, unterminated);
+
+        if (unterminated && replaceWithCommentError())
+            return;
+
+        position = i + 1;
+        return;
+    }
+
+    // whitespace only separates tokens; that is tabs and the '\r' of CRLF 
+    // line ends too, which would otherwise start a word that never grows
+    if (isCharClass(input[i], CHAR_WHITESPACE)) {
+        position = i + 1;
+        return;
+    }
+
+    char nextChar = i + 1 < input.size() ? input[i + 1] : 0; 
+    Token inputToken;
+    inputToken.offset = i;
+
+    switch(input[i]) {
+        case '"':
+            inputToken.type = DOUBLE_QUOTE;
+            inputToken.character = "\"";
+
+            if(input[i+1]=='\n' || input[i-1] == '\\'){
+                if (replaceWithCommentError())
+                    return;
+
+                syntaxError(DIAGNOSTIC_UNTERMINATED_STRING, i, 
+                            "unterminated string quote.");
+                return;
+            }
+
+            pending.push_back(inputToken);
+            inString = !inString;
+            quote = input[i];
+            break;
+
+        case '\'':
+            inputToken.type = SINGLE_QUOTE;
+            inputToken.character = "\'";
+            pending.push_back(inputToken);
+            inString = !inString;
+            quote = input[i];
+            break;
+
+        case '-':
+            if (isCharClass(nextChar, CHAR_DIGIT)) {
+                i++;
+                inputToken.type = INTEGER;
                 
-                break;
-            
-            case '>':
-                if (nextChar == '=') {
-                    inputToken.type = GT_EQUAL;
-                    inputToken.character = ">=";
-                    inputToken.lineNumber = lineNumber;
-                    tokens.push_back(inputToken);
+                while (isCharClass(input[i], CHAR_DIGIT)) {
                     i++;
-                } else {
-                    inputToken.type = GT;
-                    inputToken.character = ">";
-                    inputToken.lineNumber = lineNumber;
-                    tokens.push_back(inputToken);
                 }
 
+                inputToken.character = input.slice(inputToken.offset, i);
+                i--;
+                pending.push_back(inputToken);
                 break;
+            }
 
-            case '&':
-                if (nextChar == '&') {
-                    inputToken.type = BOOLEAN_AND_OPERATOR;
-                    inputToken.character = "&&";
-                    inputToken.lineNumber = lineNumber;
-                    tokens.push_back(inputToken);
-                    i++;
+            if (!lexOperator(i))
+                return;
+
+            break;
+
+    default:
+        if (startsOperator(input[i])) {
+            if (!lexOperator(i))
+                return;
+
+            break;
+        }
+
+        if (isCharClass(input[i], CHAR_DIGIT)) {
+            while (!isCharClass(input[i], CHAR_WHITESPACE | CHAR_SYMBOL) &&
+                   !startsComment(input, i)) {
+                if (!isCharClass(input[i], CHAR_DIGIT)) {
+                    if (replaceWithCommentError())
+                        return;
+
+                    syntaxError(DIAGNOSTIC_INVALID_INTEGER, i, 
+                                "invalid integer");
+                    return;
                 }
+
+                i++;
+            }
+            inputToken.character = input.slice(inputToken.offset, i);
+            inputToken.type = INTEGER;             
+        } else {
+            // letters, digits and '_' can never end the word, so most of
+            // it is skipped with one table load per character
+            while (isCharClass(input[i], CHAR_IDENT_CONTINUE)) {
+                i++;
+            }
+
+            while (i < input.size() && 
+                   !isCharClass(input[i], CHAR_WHITESPACE | CHAR_SYMBOL) &&
+                   !startsComment(input, i)) {
+                i++;
+            }
+
+            // a symbol that starts no token, such as a stray '\\', would 
+            // otherwise be an empty word that the lexer never gets past
+            if (i == inputToken.offset) {
+                if (replaceWithCommentError())
+                    return;
+
+                syntaxError(DIAGNOSTIC_INVALID_CHARACTER, i, 
+                            "invalid character '" + string(1, input[i]) + 
+                            "'.");
+                return;
+            }
+
+            inputToken.character = input.slice(inputToken.offset, i);
+            inputToken.type = keywordType(inputToken.character);
+
+            // chunk lexers leave interning to the thread that puts the 
+            // chunks together, instead of fighting over the table
+            if (!chunked)
+                inputToken.symbol = 
+                    IdentifierTable::get().intern(inputToken.character);
+
+            if (inputToken.type == KEYWORD_INT || 
+                inputToken.type == CHAR ||
+                inputToken.type == KEYWORD_BOOL ||
+                inputToken.type == KEYWORD_STRING) {
                 
-                break;
+                size_t index = i;
 
-            case '|':
-                if (nextChar == '|') {
-                    inputToken.type = BOOLEAN_OR_OPERATOR;
-                    inputToken.character = "||";
-                    inputToken.lineNumber = lineNumber;
-                    tokens.push_back(inputToken);
-                    i++;
+                // ignore spaces (and comments, in fused mode)
+                while (index < input.size()) {
+                    if (isCharClass(input[index], CHAR_WHITESPACE)) {
+                        index++;
+                    } else if (skipComments && startsComment(input, index)) {
+                        bool unterminated = false;
+                        index = skipComment(input, index, unterminated) + 1;
+                    } else {
+                        break;
+                    }
                 }
-                
-                break;
-            
-            case '!':
-                if (nextChar == '=') {
-                    inputToken.type = BOOLEAN_NOT_EQUAL;
-                    inputToken.character = "!=";
-                    inputToken.lineNumber = lineNumber;
-                    tokens.push_back(inputToken);
-                    i++;
-                } else {
-                    inputToken.type = BOOLEAN_NOT_OPERATOR;
-                    inputToken.character = "!";
-                    inputToken.lineNumber = lineNumber;
-                    tokens.push_back(inputToken);
+
+                // getting next token characters
+                size_t nextTokenStart = index;
+
+                while (index < input.size() && 
+                        !isCharClass(input[index], CHAR_WHITESPACE)
+                        && input[index] != ';' && input[index] != ')'
+                        && !startsComment(input, index)) {
+                    index++;
                 }
 
-                break;
+                string_view nextTokenCharacter = input.slice(nextTokenStart, 
+                                                             index);
 
-        default:
-            if (isdigit(input[i])) {
-                while (!isspace(input[i]) && !(find( listOfSymbols.begin(), 
-                listOfSymbols.end(), input[i]) != listOfSymbols.end())) {
-                    if (!isdigit(input[i])) {
-                        cout << "Syntax error on line " << lineNumber << ": invalid integer\n";
-                        exit(0);
-                    }
+                TokenType nextTokenType = keywordType(nextTokenCharacter);
 
-                    inputToken.character += input[i++];
+                if (nextTokenType == KEYWORD_INT ||
+                    nextTokenType == CHAR ||
+                    nextTokenType == KEYWORD_BOOL ||
+                    nextTokenType == KEYWORD_STRING ||
+                    nextTokenType == VOID) {
+                    
+                    if (replaceWithCommentError())
+                        return;
+
+                    syntaxError(DIAGNOSTIC_RESERVED_WORD, inputToken.offset,
+                                "reserved word \"" + 
+                                string(nextTokenCharacter) + 
+                                "\" cannot be used for the name of a "
+                                "variable.");
+                    return;
                 }
-                inputToken.type = INTEGER;             
-            } else {
-                while (!isspace(input[i]) && !(find( listOfSymbols.begin(), 
-                listOfSymbols.end(), input[i]) != listOfSymbols.end())) {
-                    inputToken.character += input[i++];
+
+                if (nextTokenType == KEYWORD_PRINTF) {
+                    if (replaceWithCommentError())
+                        return;
+
+                    syntaxError(DIAGNOSTIC_RESERVED_WORD, inputToken.offset,
+                                "reserved word \"printf\" cannot be used "
+                                "for the name of a function.");
+                    return;
                 }
+            }
+        }
 
-                if (inputToken.character == "int" || 
-                    inputToken.character == "char" ||
-                    inputToken.character == "bool" ||
-                    inputToken.character == "string") {
-                    
-                    int index = i;
-                    string nextTokenCharacter = "";
+        i--;
+        pending.push_back(inputToken);
 
-                    // ignore spaces
-                    while (index < input.size() && isspace(input[index])) {
-                        index++;
-                    }
 
-                    // getting next token characters
-                    while (index < input.size() && !isspace(input[index])
-                            && input[index] != ';' && input[index] != ')') {
-                        nextTokenCharacter += input[index++];
-                    }
+        break;
+    }
 
-                    if (nextTokenCharacter == "int" ||
-                        nextTokenCharacter == "char" ||
-                        nextTokenCharacter == "bool" ||
-                        nextTokenCharacter == "string" ||
-                        nextTokenCharacter == "void") {
-                        
-                        cerr << "Syntax error on line " << lineNumber
-                             << ": reserved word \"" << nextTokenCharacter
-                             << "\" cannot be used for the name of a "
-                             << "variable.\n";
-                        exit(0);
-                    }
+    position = i + 1;
+}
 
-                    if (nextTokenCharacter == "printf") {
-                        cerr << "Syntax error on line " << lineNumber
-                             << ": reserved word \"printf\" cannot be used "
-                             << "for the name of a function.\n";
-                        exit(0);
-                    }
-                }
-            
-                inputToken.type = IDENTIFIER;
-            }
+/**
+ * @brief Constructor
+ * @param program - The characters the tokens were lexed from
+ * @param lineIndex - The line index for program
+ */
+TokenStream::TokenStream(string_view program, const LineIndex& lineIndex)
+    : program(program), lineIndex(&lineIndex) { }
 
-            i--;
-            inputToken.lineNumber = lineNumber;
-            tokens.push_back(inputToken);
+/**
+ * @brief Adds a token to the end of the stream
+ * @param token - A token lexed from the program
+ */
+void TokenStream::push_back(const Token& token) {
+    types.push_back(token.type);
+    offsets.push_back(token.offset);
+    lengths.push_back(token.character.size());
+    symbols.push_back(token.symbol);
+}
 
+/**
+ * @brief Removes every token, keeping the memory of the arrays
+ * @param program - The characters the next tokens are lexed from
+ */
+void TokenStream::clear(string_view program) {
+    this->program = program;
+    types.clear();
+    offsets.clear();
+    lengths.clear();
+    symbols.clear();
+    lines.clear();
+}
+
+/**
+ * @brief Returns the line number (starting at 1) of the i-th token
+ * @remark Offsets only grow, so the line numbers are found by walking the
+ *         tokens and the line index side by side instead of a binary search
+ *         per token
+ */
+int TokenStream::getLineNumber(size_t i) const {
+    if (lines.size() != offsets.size()) {
+        lines.resize(offsets.size());
+        int line = 1;
+
+        for (size_t j = 0; j < offsets.size(); j++) {
+            while (lineIndex->getLineStart(line + 1) <= offsets[j])
+                line++;
+
+            lines[j] = line;
+        }
+    }
+
+    return lines[i];
+}
+
+/**
+ * @brief Constructor
+ * @param input - A string representing a C-style program 
+ * @remark Constructs Tokenization object by tokenizing the input program and
+ *          storing tokens in private variable. The tokens point into input, 
+ *          so input has to outlive the Tokenization.
+ */
+Tokenization::Tokenization(const string& input) 
+    : lexer(input), 
+      tokens(lexer.getProgram(), lexer.getLineIndex()), restarted(false) {
+    collect();
+}
+
+/**
+ * @brief Constructor
+ * @param stripped - A C-style program that has been through IgnoreComments
+ */
+Tokenization::Tokenization(const IgnoreComments& stripped) 
+    : lexer(stripped), 
+      tokens(lexer.getProgram(), lexer.getLineIndex()), restarted(false) {
+    collect();
+}
 
+/**
+ * @brief Constructor
+ * @param stripped - A C-style program that has been through IgnoreComments
+ * @param threads - How many threads may lex the program
+ */
+Tokenization::Tokenization(const IgnoreComments& stripped, unsigned threads) 
+    : lexer(stripped), 
+      tokens(lexer.getProgram(), lexer.getLineIndex()), restarted(false) {
+    collectInParallel(threads);
+}
+
+/**
+ * @brief Constructor
+ * @param source - A C-style program that may still contain comments
+ * @param threads - How many threads may lex the program
+ * @remark Fused mode, see Lexer(const SourceBuffer&)
+ */
+Tokenization::Tokenization(const SourceBuffer& source, unsigned threads) 
+    : lexer(source), 
+      tokens(lexer.getProgram(), lexer.getLineIndex()), restarted(false) {
+    collectInParallel(threads);
+}
+
+/**
+ * @brief Constructor
+ * @param source - A C-style program that may still contain comments
+ * @remark Fused mode, see Lexer(const SourceBuffer&)
+ */
+Tokenization::Tokenization(const SourceBuffer& source) 
+    : lexer(source), 
+      tokens(lexer.getProgram(), lexer.getLineIndex()), restarted(false) {
+    collect();
+}
+
+/**
+ * @brief Pulls every token out of the lexer into private variable
+ */
+void Tokenization::collect() {
+    Token token;
+
+    while (lexer.next(token)) {
+        // the tokens before a restart belong to a program IgnoreComments 
+        // would have rejected
+        if (lexer.hasRestarted() && !restarted) {
+            tokens.clear(lexer.getProgram());
+            restarted = true;
+        }
+
+        tokens.push_back(token);
+    }
+}
+
+/**
+ * @brief Lexes chunks of the program on separate threads, then puts their 
+ *        tokens together into private variable
+ * @param threads - The most chunks to lex at once
+ * @remark Every chunk but the first is lexed on the guess that it starts 
+ *         between tokens and outside any literal or comment, which holds 
+ *         unless one of those runs across a newline. The guess is checked against where
+ *         the chunk before it actually stopped, and a chunk that was started 
+ *         wrong is lexed again from there. Errors are left to the serial
+ *         lexer so that the first one in the program is the one reported.
+ */
+void Tokenization::collectInParallel(unsigned threads) {
+    const LexerInput& input = lexer.input;
+    size_t chunkCount = min<size_t>(threads, 
+                                    input.size() / PARALLEL_CHUNK_MIN_SIZE);
+
+    // a program rejected before lexing starts has nothing to split
+    if (chunkCount <= 1 || lexer.hasError()) {
+        collect();
+        return;
+    }
+
+    // each chunk starts just after a newline
+    vector<size_t> starts(1, 0);
+
+    for (size_t k = 1; k < chunkCount; k++) {
+        size_t from = max(k * input.size() / chunkCount, starts.back());
+        const void* newline = memchr(input.data + from, '\n', 
+                                     input.size() - from);
+
+        if (newline == nullptr)
             break;
+
+        size_t start = static_cast<const char*>(newline) - input.data + 1;
+
+        if (start < input.size())
+            starts.push_back(start);
+    }
+
+    starts.push_back(input.size());
+    chunkCount = starts.size() - 1;
+
+    vector<unique_ptr<Lexer>> chunks;
+    vector<thread> workers;
+
+    for (size_t k = 0; k < chunkCount; k++) {
+        chunks.emplace_back(new Lexer(lexer, starts[k], starts[k + 1], false,
+                                      '\0'));
+        workers.emplace_back(&Lexer::lexChunk, chunks.back().get());
+    }
+
+    for (thread& worker : workers)
+        worker.join();
+
+    for (size_t k = 0; k < chunkCount; k++) {
+        if (k > 0) {
+            const Lexer& previous = *chunks[k - 1];
+
+            if (previous.position != starts[k] || previous.inString) {
+                chunks[k].reset(new Lexer(lexer, previous.position, 
+                                          starts[k + 1], previous.inString,
+                                          previous.quote));
+                chunks[k]->lexChunk();
+            }
+        }
+
+        if (chunks[k]->failed) {
+            tokens.clear(lexer.getProgram());
+            collect();
+            return;
+        }
+
+        IdentifierTable& identifiers = IdentifierTable::get();
+
+        for (Token& token : chunks[k]->pending) {
+            if (isWord(token.type))
+                token.symbol = identifiers.intern(token.character);
+
+            tokens.push_back(token);
         }
     }
 }
-    
 
 /**
  * @brief Output operator overload
@@ -355,19 +1084,29 @@ Tokenization::Tokenization(const string& input) {
 ostream& operator << (ostream& os, const Tokenization& obj) {
     os << "Token list: " << '\n' << '\n';
 
-    for (const auto& token: obj.tokens) {
+    for (size_t i = 0; i < obj.tokens.size(); i++) {
+        Token token = obj.tokens[i];
         string tokenType = "Token type: ";
         string tokenString = "Token: ";
 
         switch (token.type) {
+            // keywords are printed as identifiers, as the project 2 spec 
+            // expects
+            case CHAR:
             case VOID:
-                tokenType += "VOID";
-                break;
-
-            case CHAR: 
-                tokenType += "CHAR";
-                break;
-
+            case BOOLEAN_TRUE:
+            case BOOLEAN_FALSE:
+            case KEYWORD_INT:
+            case KEYWORD_BOOL:
+            case KEYWORD_STRING:
+            case KEYWORD_FUNCTION:
+            case KEYWORD_PROCEDURE:
+            case KEYWORD_IF:
+            case KEYWORD_ELSE:
+            case KEYWORD_FOR:
+            case KEYWORD_WHILE:
+            case KEYWORD_RETURN:
+            case KEYWORD_PRINTF:
             case IDENTIFIER:
                 tokenType += "IDENTIFIER";
                 break;
@@ -483,15 +1222,6 @@ ostream& operator << (ostream& os, const Tokenization& obj) {
             case BOOLEAN_NOT_EQUAL:
                 tokenType += "BOOLEAN_NOT_EQUAL";
                 break;
-
-            case BOOLEAN_TRUE:
-                tokenType += "BOOLEAN_TRUE";
-                break;
-
-            case BOOLEAN_FALSE:
-                tokenType += "BOOLEAN_FALSE";
-                break;
-
         }
 
         tokenString += token.character;
@@ -503,8 +1233,32 @@ ostream& operator << (ostream& os, const Tokenization& obj) {
 
 /**
  * @brief Getter for tokens private variable
- * @returns The tokens vector
+ * @returns The token stream, without copying it
  */
-vector<Token> Tokenization::getTokens() {
+const TokenStream& Tokenization::getTokens() const {
     return tokens;
-}
\ No newline at end of file
+}
+
+/**
+ * @brief Getter for the lexer's line index
+ * @returns The line index for the offsets stored in the tokens
+ */
+const LineIndex& Tokenization::getLineIndex() const {
+    return lexer.getLineIndex();
+}
+
+/**
+ * @brief Returns true if the program was rejected; the tokens are the ones
+ *        before the error
+ */
+bool Tokenization::hasError() const {
+    return lexer.hasError();
+}
+
+/**
+ * @brief Getter for the lexer's diagnostic
+ * @returns The syntax error the program was rejected for
+ */
+const Diagnostic& Tokenization::getDiagnostic() const {
+    return lexer.getDiagnostic();
+}
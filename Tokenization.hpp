@@ -9,11 +9,16 @@
 #define TOKENIZATION_HPP
 
 #include "IgnoreComments.hpp"
+#include "Diagnostic.hpp"
+#include "IdentifierTable.hpp"
+#include "LineIndex.hpp"
 #include <iostream>
 #include <fstream> //Including fstream and string allow us to read in the input file
 #include <string>
+#include <string_view>
 #include <vector> 
 #include <cctype>
+#include <cstdint>
 #include <algorithm>
 
 using namespace std;
@@ -56,17 +61,436 @@ enum TokenType {
     BOOLEAN_NOT_EQUAL,
     BOOLEAN_TRUE,
     BOOLEAN_FALSE,
+    KEYWORD_INT,
+    KEYWORD_BOOL,
+    KEYWORD_STRING,
+    KEYWORD_FUNCTION,
+    KEYWORD_PROCEDURE,
+    KEYWORD_IF,
+    KEYWORD_ELSE,
+    KEYWORD_FOR,
+    KEYWORD_WHILE,
+    KEYWORD_RETURN,
+    KEYWORD_PRINTF,
     // NONEXISTENT,
 };
 
+/**
+ * @brief Returns true if type is one of the keyword types the lexer gives
+ *        reserved words instead of IDENTIFIER
+ * @remark The keywords are CHAR, VOID and everything from BOOLEAN_TRUE on
+ */
+inline bool isKeyword(TokenType type) {
+    return type == CHAR || type == VOID || type >= BOOLEAN_TRUE;
+}
+
+/**
+ * @brief Returns true if type is IDENTIFIER or a keyword, which is every 
+ *        token that is a word
+ */
+inline bool isWord(TokenType type) {
+    return type == IDENTIFIER || isKeyword(type);
+}
+
 /**
  * @struct Token
  * @brief Encapsulates a token type and the actual character(s) of the token
+ * @remark offset is where the token starts in the tokenized program; its 
+ *         line number comes from the Tokenization's LineIndex
+ * @remark character points into the tokenized program (or at a string 
+ *         literal), so tokens never allocate and are cheap to copy, but the
+ *         program has to outlive them. Make a string from it when the text 
+ *         has to outlive the program.
+ * @remark symbol is the word's number in the IdentifierTable, so words 
+ *         can be compared without looking at their characters; NO_SYMBOL 
+ *         for tokens that are not words
  */
 struct Token {
     TokenType type;
-    string character;
-    int lineNumber;
+    string_view character;
+    uint32_t offset;
+    SymbolId symbol = NO_SYMBOL;
+};
+
+/**
+ * @struct LexerInput
+ * @brief The characters being tokenized
+ * @remark Reading past the end gives '\0', the same as reading one past the
+ *         end of a std::string, so the lexer can look ahead without bounds
+ *         checks even when the characters come straight from a mapped file
+ */
+struct LexerInput {
+    const char* data;
+    size_t length;
+
+    char operator [] (size_t i) const { return i < length ? data[i] : '\0'; }
+    size_t size() const { return length; }
+
+    /**
+     * @brief Returns the characters from begin up to end, without copying
+     */
+    string_view slice(size_t begin, size_t end) const { 
+        return string_view(data + begin, end - begin); 
+    }
+};
+
+/**
+ * @brief A program is only split into chunks of at least this many 
+ *        characters, so that starting a thread pays off
+ */
+const size_t PARALLEL_CHUNK_MIN_SIZE = 1 << 16;
+
+/**
+ * @brief The most characters a program can have: token offsets, line starts
+ *        and CST node indices are 32 bits
+ */
+const size_t MAX_PROGRAM_SIZE = UINT32_MAX;
+
+/**
+ * @class Lexer
+ * @brief Produces the tokens of a C-style program one at a time
+ * @remark Tokens are lexed on demand, so only the tokens that have been 
+ *         peeked at but not taken yet are held in memory
+ */
+class Lexer {
+public:
+    /**
+     * @brief Constructor
+     * @remark Lexes an empty program until reset is called
+     */
+    Lexer();
+
+    /**
+     * @brief Constructor
+     * @param input - A string representing a C-style program without comments
+     */
+    Lexer(const string& input);
+
+    /**
+     * @brief Constructor
+     * @param stripped - A C-style program that has been through IgnoreComments
+     */
+    Lexer(const IgnoreComments& stripped);
+
+    /**
+     * @brief Constructor
+     * @param source - A C-style program that may still contain comments
+     * @remark Skips comments while tokenizing, instead of needing the output
+     *         of IgnoreComments
+     */
+    Lexer(const SourceBuffer& source);
+
+    /**
+     * @brief Starts over on another program, keeping the memory of the 
+     *        pending tokens and the line index
+     * @param source - A C-style program that may still contain comments
+     * @remark Lexes the same way as Lexer(const SourceBuffer&)
+     */
+    void reset(const SourceBuffer& source);
+
+    /**
+     * @brief Moves the next token into token
+     * @param token - Receives the next token
+     * @returns False once every token has been returned
+     */
+    bool next(Token& token);
+
+    /**
+     * @brief Looks at a token without consuming it
+     * @param k - How many tokens ahead to look; 0 is the token next() returns
+     * @returns The token, or nullptr if the program has fewer tokens left
+     * @remark The pointer is only valid until the next call to next() or
+     *         peek()
+     */
+    const Token* peek(size_t k = 0);
+
+    /**
+     * @brief Getter for lineIndex private variable
+     * @returns The line index for the offsets stored in the tokens
+     */
+    const LineIndex& getLineIndex() const;
+
+    /**
+     * @brief Returns the characters being tokenized, which the offsets of the
+     *        tokens are relative to
+     */
+    string_view getProgram() const;
+
+    /**
+     * @brief Returns true if the lexer restarted on IgnoreComments' error
+     *        message; tokens returned before that are not part of the program
+     */
+    bool hasRestarted() const;
+
+    /**
+     * @brief Returns true if the lexer stopped on a syntax error; next() 
+     *        returns false from then on
+     */
+    bool hasError() const;
+
+    /**
+     * @brief Getter for diagnostic private variable
+     * @returns The syntax error the lexer stopped on
+     */
+    const Diagnostic& getDiagnostic() const;
+
+private:
+    /**
+     * @brief Lexes until more than k tokens are pending or the input runs out
+     * @param k - The index of the pending token that is needed
+     * @returns True if the k-th token not taken yet exists
+     */
+    bool fill(size_t k);
+
+    /**
+     * @brief Lexes the characters at position, adding any tokens they finish
+     *        to pending
+     */
+    void step();
+
+    /**
+     * @brief Lexes the operator that starts at index i, adding it to pending
+     * @param i - The index of the operator's first character; moved to its
+     *            last
+     * @returns False if the lexer restarted on IgnoreComments' error or
+     *          stopped on a syntax error instead
+     */
+    bool lexOperator(size_t& i);
+
+    /**
+     * @brief Constructor for lexing one chunk of a program
+     * @param whole - A lexer for the whole program that has not started yet
+     * @param begin - The index to start lexing at
+     * @param end - Tokens that start at or after end are left for the next 
+     *              chunk
+     * @param inString - True if begin is inside a string or character 
+     *                   literal
+     * @param quote - The quote that opened that literal
+     */
+    Lexer(const Lexer& whole, size_t begin, size_t end, bool inString, 
+          char quote);
+
+    /**
+     * @brief Lexes every token that starts before end into pending
+     */
+    void lexChunk();
+
+    /**
+     * @brief Stops the lexer on a syntax error, keeping it in diagnostic
+     * @param code - Which error it is
+     * @param offset - Where in input the error is
+     * @param message - What is wrong
+     */
+    void syntaxError(DiagnosticCode code, size_t offset, 
+                     const string& message);
+
+    /**
+     * @brief Stops the lexer before it starts if the program is larger than 
+     *        MAX_PROGRAM_SIZE
+     * @returns True if it did
+     */
+    bool rejectTooLarge();
+
+    /**
+     * @brief Checks whether IgnoreComments would have rejected the program
+     * @returns True if it would, in which case the lexer starts over on
+     *          IgnoreComments' error message
+     */
+    bool replaceWithCommentError();
+
+    /**
+     * @brief The characters being tokenized
+     */
+    LexerInput input;
+
+    /**
+     * @brief True if input may still contain comments
+     */
+    bool skipComments;
+
+    /**
+     * @brief The index of the next character to lex
+     */
+    size_t position;
+
+    /**
+     * @brief True between the quotes of a string or character literal
+     */
+    bool inString;
+
+    /**
+     * @brief The quote character that opened the current literal
+     */
+    char quote;
+
+    /**
+     * @brief True once the lexer has restarted on IgnoreComments' error 
+     */
+    bool restarted;
+
+    /**
+     * @brief Line starts of input
+     */
+    LineIndex lineIndex;
+
+    /**
+     * @brief Holds IgnoreComments' error message after a restart
+     */
+    string replacement;
+
+    /**
+     * @brief Tokens that have been lexed; the ones from first on have not
+     *        been returned by next() yet
+     */
+    vector<Token> pending;
+
+    /**
+     * @brief Index in pending of the token next() returns
+     */
+    size_t first;
+
+    /**
+     * @brief Where lexing stops; the end of input except for chunk lexers
+     */
+    size_t end;
+
+    /**
+     * @brief True for a lexer working on one chunk of a program
+     */
+    bool chunked;
+
+    /**
+     * @brief True once the lexer has run into a syntax error
+     */
+    bool failed;
+
+    /**
+     * @brief The syntax error the lexer stopped on; chunk lexers leave it
+     *        empty, since their errors are found again by the serial lexer
+     */
+    Diagnostic diagnostic;
+
+    /**
+     * @brief Splits a program into chunk lexers
+     */
+    friend class Tokenization;
+};
+
+/**
+ * @class TokenStream
+ * @brief Every token of a program, kept as separate arrays of types, offsets
+ *        and lengths instead of an array of Tokens
+ * @remark A parser that only looks at token types walks one byte per token
+ *         instead of a whole Token, and the text is only touched for the
+ *         tokens it actually compares. A token's text is always the
+ *         characters of the program at its offset, so the text itself is
+ *         never stored. Line numbers are a sidecar column that is only built
+ *         the first time one is asked for.
+ */
+class TokenStream {
+public:
+    /**
+     * @brief Constructor
+     * @param program - The characters the tokens were lexed from
+     * @param lineIndex - The line index for program
+     * @remark program and lineIndex have to outlive the TokenStream
+     */
+    TokenStream(string_view program, const LineIndex& lineIndex);
+
+    /**
+     * @brief Adds a token to the end of the stream
+     * @param token - A token lexed from the program
+     */
+    void push_back(const Token& token);
+
+    /**
+     * @brief Removes every token, keeping the memory of the arrays
+     * @param program - The characters the next tokens are lexed from
+     */
+    void clear(string_view program);
+
+    /**
+     * @brief Getter for the number of tokens
+     */
+    size_t size() const { return types.size(); }
+
+    /**
+     * @brief Returns the type of the i-th token
+     */
+    TokenType type(size_t i) const { return TokenType(types[i]); }
+
+    /**
+     * @brief Returns the offset of the i-th token in the program
+     */
+    uint32_t offset(size_t i) const { return offsets[i]; }
+
+    /**
+     * @brief Returns the IdentifierTable number of the i-th token
+     */
+    SymbolId symbol(size_t i) const { return symbols[i]; }
+
+    /**
+     * @brief Returns the characters of the i-th token, without copying them
+     */
+    string_view text(size_t i) const {
+        return program.substr(offsets[i], lengths[i]);
+    }
+
+    /**
+     * @brief Puts the i-th token back together
+     */
+    Token operator [] (size_t i) const {
+        return Token{type(i), text(i), offsets[i], symbols[i]};
+    }
+
+    /**
+     * @brief Returns the line number (starting at 1) of the i-th token
+     * @remark The first call numbers every token in one pass over the line
+     *         index, so each call after that is a single array read
+     */
+    int getLineNumber(size_t i) const;
+
+    /**
+     * @brief Getter for lineIndex private variable
+     */
+    const LineIndex& getLineIndex() const { return *lineIndex; }
+
+private:
+    /**
+     * @brief The characters the tokens were lexed from
+     */
+    string_view program;
+
+    /**
+     * @brief The line index for program
+     */
+    const LineIndex* lineIndex;
+
+    /**
+     * @brief The TokenType of every token
+     */
+    vector<uint8_t> types;
+
+    /**
+     * @brief Where every token starts in program
+     */
+    vector<uint32_t> offsets;
+
+    /**
+     * @brief The number of characters in every token
+     */
+    vector<uint32_t> lengths;
+
+    /**
+     * @brief The IdentifierTable number of every token
+     */
+    vector<SymbolId> symbols;
+
+    /**
+     * @brief The line number of every token; empty until getLineNumber is
+     *        first called
+     */
+    mutable vector<uint32_t> lines;
 };
 
 /**
@@ -81,6 +505,47 @@ public:
      */
     Tokenization(const string& input);
 
+    /**
+     * @brief Constructor
+     * @param source - A C-style program that may still contain comments
+     * @remark Skips comments while tokenizing, instead of needing the output
+     *         of IgnoreComments
+     */
+    Tokenization(const SourceBuffer& source);
+
+    /**
+     * @brief Constructor
+     * @param stripped - A C-style program that has been through IgnoreComments
+     */
+    Tokenization(const IgnoreComments& stripped);
+
+    /**
+     * @brief Constructor
+     * @param stripped - A C-style program that has been through IgnoreComments
+     * @param threads - How many threads may lex the program
+     * @remark Splits the program into chunks at newlines and lexes them at
+     *         the same time. Gives exactly the tokens the other constructors
+     *         give.
+     */
+    Tokenization(const IgnoreComments& stripped, unsigned threads);
+
+    /**
+     * @brief Constructor
+     * @param source - A C-style program that may still contain comments
+     * @param threads - How many threads may lex the program
+     * @remark Skips comments while tokenizing, like 
+     *         Tokenization(const SourceBuffer&), and splits the program the
+     *         same way as Tokenization(const IgnoreComments&, unsigned)
+     */
+    Tokenization(const SourceBuffer& source, unsigned threads);
+
+    /**
+     * @brief The token stream points at the lexer's line index, so a 
+     *        Tokenization cannot be copied
+     */
+    Tokenization(const Tokenization&) = delete;
+    Tokenization& operator = (const Tokenization&) = delete;
+
     /**
      * @brief Output operator overload
      * @param os - The output stream operator
@@ -94,43 +559,56 @@ public:
 
     /**
      * @brief Getter for tokens private variable
-     * @returns The tokens vector
-     */
-    vector<Token> getTokens();
-
-    /**
-     * @brief The actual characters of some of the token types
-     */
-    vector<char> listOfSymbols = {
-        '(', 
-        ')', 
-        '[', 
-        ']', 
-        '{', 
-        '}', 
-        '\"', 
-        '\'', 
-        ';', 
-        ',', 
-        '=', 
-        '+', 
-        '-', 
-        '\\',
-        '*', 
-        '%', 
-        '^', 
-        '>', 
-        '<', 
-        '&', 
-        '|', 
-        '!'
-    };
+     * @returns The token stream, without copying it
+     */
+    const TokenStream& getTokens() const;
+
+    /**
+     * @brief Getter for the lexer's line index
+     * @returns The line index for the offsets stored in the tokens
+     */
+    const LineIndex& getLineIndex() const;
+
+    /**
+     * @brief Returns true if the program was rejected; the tokens are the 
+     *        ones before the error
+     */
+    bool hasError() const;
+
+    /**
+     * @brief Getter for the lexer's diagnostic
+     * @returns The syntax error the program was rejected for
+     */
+    const Diagnostic& getDiagnostic() const;
 
 private:
+    /**
+     * @brief Pulls every token out of the lexer into private variable
+     */
+    void collect();
+
+    /**
+     * @brief Lexes chunks of the program on separate threads, then puts 
+     *        their tokens together into private variable
+     * @param threads - The most chunks to lex at once
+     */
+    void collectInParallel(unsigned threads);
+
+    /**
+     * @brief Produces the tokens; kept because after a restart the tokens 
+     *        point into the lexer's copy of IgnoreComments' error message
+     */
+    Lexer lexer;
+
     /**
      * @brief Contains the tokens from the input C program
      */
-    vector<Token> tokens;
+    TokenStream tokens;
+
+    /**
+     * @brief True once tokens from before a lexer restart have been dropped
+     */
+    bool restarted;
 };
 
 #endif
\ No newline at end of file
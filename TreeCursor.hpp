@@ -0,0 +1,220 @@
+/**
+ * @file TreeCursor.hpp
+ * @brief Defines the traversals that work on any tree a cursor can walk
+ * @authors Jacob Franco, Zach Gassner, Haley Joerger, Adam Lyday
+ */
+
+#ifndef TREE_CURSOR_HPP
+#define TREE_CURSOR_HPP
+
+#include <cassert>
+#include <iostream>
+#include <iterator>
+
+using namespace std;
+
+/**
+ * @remark A cursor points at one node of a left child right sibling tree,
+ *         or at no node. Every tree representation has one, and they all
+ *         have the same members, so code written against a cursor works on
+ *         any of them:
+ *
+ *      explicit operator bool() - false for no node
+ *      token() - the token the node holds
+ *      leftChild() - the first node of the next statement
+ *      rightSibling() - the next node of the same statement
+ *
+ *         Cursors are small values, so they are passed and copied freely.
+ *
+ * @remark Every tree the front end builds has one statement on each level:
+ *         a statement is a chain of right siblings, and only its last node
+ *         has a left child, the first node of the next statement. So the
+ *         walks below need no queue or stack, and never allocate. Level
+ *         order and pre-order both visit the nodes in the order of their
+ *         tokens.
+ */
+
+/**
+ * @class SiblingIterator
+ * @brief Steps through a chain of right siblings, for range-based for loops
+ */
+template <typename Cursor>
+class SiblingIterator {
+public:
+    using iterator_category = forward_iterator_tag;
+    using value_type = Cursor;
+    using difference_type = ptrdiff_t;
+    using pointer = const Cursor*;
+    using reference = const Cursor&;
+
+    /**
+     * @brief Constructor
+     * @param node - The node to start at; no node is the end
+     */
+    explicit SiblingIterator(Cursor node = Cursor()) : node(node) { }
+
+    const Cursor& operator * () const { return node; }
+
+    SiblingIterator& operator ++ () {
+        node = node.rightSibling();
+        return *this;
+    }
+
+    /**
+     * @remark Only the end is ever compared against, so the iterators are
+     *         equal when both are at the end or neither is
+     */
+    bool operator == (const SiblingIterator& other) const {
+        return bool(node) == bool(other.node);
+    }
+
+    bool operator != (const SiblingIterator& other) const {
+        return !(*this == other);
+    }
+
+private:
+    /**
+     * @brief The node pointed at
+     */
+    Cursor node;
+};
+
+/**
+ * @class StatementIterator
+ * @brief Steps from the first node of one statement to the first node of
+ *        the next, for range-based for loops
+ */
+template <typename Cursor>
+class StatementIterator {
+public:
+    using iterator_category = forward_iterator_tag;
+    using value_type = Cursor;
+    using difference_type = ptrdiff_t;
+    using pointer = const Cursor*;
+    using reference = const Cursor&;
+
+    /**
+     * @brief Constructor
+     * @param statement - The first node of the statement to start at; no
+     *                    node is the end
+     */
+    explicit StatementIterator(Cursor statement = Cursor())
+        : statement(statement) { }
+
+    const Cursor& operator * () const { return statement; }
+
+    StatementIterator& operator ++ () {
+        Cursor last = statement;
+
+        while (last.rightSibling()) {
+            // a node in the middle of a statement never starts another one
+            assert(!last.leftChild());
+            last = last.rightSibling();
+        }
+
+        statement = last.leftChild();
+        return *this;
+    }
+
+    /**
+     * @remark Only the end is ever compared against, so the iterators are
+     *         equal when both are at the end or neither is
+     */
+    bool operator == (const StatementIterator& other) const {
+        return bool(statement) == bool(other.statement);
+    }
+
+    bool operator != (const StatementIterator& other) const {
+        return !(*this == other);
+    }
+
+private:
+    /**
+     * @brief The first node of the statement pointed at
+     */
+    Cursor statement;
+};
+
+/**
+ * @struct CursorRange
+ * @brief A begin and end iterator, for range-based for loops
+ */
+template <typename Iterator>
+struct CursorRange {
+    Iterator first;
+
+    Iterator begin() const { return first; }
+    Iterator end() const { return Iterator(); }
+};
+
+/**
+ * @brief Returns the nodes of one statement
+ * @param statement - A cursor at the first node of the statement
+ * @remark ex: for (Cursor node : siblings(statement))
+ */
+template <typename Cursor>
+CursorRange<SiblingIterator<Cursor>> siblings(Cursor statement) {
+    return {SiblingIterator<Cursor>(statement)};
+}
+
+/**
+ * @brief Returns the first node of every statement
+ * @param root - A cursor at the root of a tree, or at no node
+ * @remark ex: for (Cursor statement : statements(root))
+ */
+template <typename Cursor>
+CursorRange<StatementIterator<Cursor>> statements(Cursor root) {
+    return {StatementIterator<Cursor>(root)};
+}
+
+/**
+ * @brief Calls visit(node, level) on every node, a level at a time
+ * @param root - A cursor at the root of a tree, or at no node
+ * @param visit - Called with a cursor at each node and the node's level
+ */
+template <typename Cursor, typename Visitor>
+void levelOrder(Cursor root, Visitor visit) {
+    int level = 0;
+
+    for (Cursor statement : statements(root)) {
+        for (Cursor node : siblings(statement))
+            visit(node, level);
+
+        level++;
+    }
+}
+
+/**
+ * @brief Calls visit(node) on every node, each node before its left child
+ *        and its left child before its right sibling
+ * @param root - A cursor at the root of a tree, or at no node
+ * @param visit - Called with a cursor at each node
+ */
+template <typename Cursor, typename Visitor>
+void preOrder(Cursor root, Visitor visit) {
+    levelOrder(root, [&visit](Cursor node, int) { visit(node); });
+}
+
+/**
+ * @brief Writes every level of a tree on its own line
+ * @param os - The output stream
+ * @param root - A cursor at the root of a tree, or at no node
+ * @returns The modified output stream
+ */
+template <typename Cursor>
+ostream& printLevelOrder(ostream& os, Cursor root) {
+    int currentLevel = 0;
+
+    levelOrder(root, [&os, &currentLevel](Cursor node, int level) {
+        if (level != currentLevel) {
+            os << '\n';
+            currentLevel = level;
+        }
+
+        os << node.token().character << ' ';
+    });
+
+    return os << '\n';
+}
+
+#endif
@@ -1,5 +1,5 @@
 #include "abstractsyntaxtree.hpp"
-#include <queue>
+#include "TreeCursor.hpp"
 #include <string>
 #include <sstream>
 #include <cassert>
@@ -120,80 +120,90 @@ inline auto toTokenType(Token token)
 
     case BOOLEAN_FALSE:
         return "BOOLEAN_FALSE";
+
+    // the other keywords are printed as identifiers, as they were before 
+    // they had types of their own
+    case KEYWORD_INT:
+    case KEYWORD_BOOL:
+    case KEYWORD_STRING:
+    case KEYWORD_FUNCTION:
+    case KEYWORD_PROCEDURE:
+    case KEYWORD_IF:
+    case KEYWORD_ELSE:
+    case KEYWORD_FOR:
+    case KEYWORD_WHILE:
+    case KEYWORD_RETURN:
+    case KEYWORD_PRINTF:
+        return "IDENTIFIER";
     }
+
+    return "IDENTIFIER";
 }
 
 /**
- * @brief Constructor
- * @param tokens - A vector of tokens from a C-style program
+ * @brief Constructs AbstractSyntaxTree object
+ * @param concreteSyntaxTree - The concrete syntax tree that was generated in
+ *                                                      RecursiveDescentParser
  */
-AbstractSyntaxTree::AbstractSyntaxTree(const vector<Token> &tokens)
+AbstractSyntaxTree::AbstractSyntaxTree(const RecursiveDescentParser& concreteSyntaxTree, 
+                                       const SymbolTable& symbolTable)
+    : abstractSyntaxTree(nullptr)
 {
+    build(concreteSyntaxTree.getStatements(), symbolTable);
 }
 
 /**
  * @brief Constructs AbstractSyntaxTree object
- * @param concreteSyntaxTree - The concrete syntax tree that was generated in
- *                                                      RecursiveDescentParser
+ * @param concreteSyntaxTree - The compact CST of the program
+ * @param symbolTable - The symbol table built from the same CST
  */
-AbstractSyntaxTree::AbstractSyntaxTree(RecursiveDescentParser concreteSyntaxTree, SymbolTable symbolTable)
+AbstractSyntaxTree::AbstractSyntaxTree(const CompactTree& concreteSyntaxTree, 
+                                       const SymbolTable& symbolTable)
+    : abstractSyntaxTree(nullptr)
 {
-    LCRS *cst = concreteSyntaxTree.getConcreteSyntaxTree();
-
-    // cout << cst->token.character << "^^^^^\n";
+    build(concreteSyntaxTree.getStatements(), symbolTable);
+}
 
-    vector<vector<Token>> result; // 2D vector to hold the tokens by levels
-    queue<pair<LCRS *, int>> q;   // Queue to hold nodes along with their level
-    q.push({cst, 0});             // Start with the root at level 0
+/**
+ * @brief Copies the tokens of a statement into a line, reusing its memory
+ * @param statement - A statement from the CST's statement table
+ * @param line - Receives the statement's tokens
+ */
+template <typename Cursor>
+static void getLine(const Statement<Cursor>& statement, vector<Token>& line)
+{
+    line.clear();
+    line.reserve(statement.tokenCount);
 
-    while (!q.empty())
+    for (Cursor node : siblings(statement.first))
     {
-        auto front = q.front(); // Get the front item (node and its level)
-        q.pop();
-
-        LCRS *currentNode = front.first;
-        int level = front.second;
-
-        // Ensure the vector is large enough to hold this level
-        if (level >= result.size())
-        {
-            result.resize(level + 1); // Resize to accommodate new level
-        }
-
-        // Add the current node's token to the appropriate level
-        result[level].push_back(currentNode->token);
-
-        // Enqueue left child if exists, at the next level
-        if (currentNode->leftChild)
-        {
-            q.push({currentNode->leftChild, level + 1});
-        }
-
-        // Enqueue right sibling if exists, at the same level
-        if (currentNode->rightSibling)
-        {
-            q.push({currentNode->rightSibling, level});
-        }
+        line.push_back(node.token());
     }
+}
 
-    /*
-    for (auto & x : result) {
-        for (auto k : x) {
-            cout << k.character << ' ';
-        }
-
-        cout << '\n';
-    }
-    */
+/**
+ * @brief Builds the AST
+ * @param statements - The statement table of the CST, one line of the AST
+ *                     for each statement
+ * @param symbolTable - The symbol table built from the same CST
+ */
+template <typename Cursor>
+void AbstractSyntaxTree::build(const StatementTable<Cursor>& statements, 
+                               const SymbolTable& symbolTable)
+{
+    // the tokens of one statement at a time, so the whole CST is never 
+    // copied
+    vector<Token> line;
 
    //vector<Token>listOfProFuncs;
 
     
-    for(int line = 0; line < result.size(); line++){
-        findFunctionProcedureCall(result[line], symbolTable.table);
-            //listOfProFuncs.push_back(result[line][1]);
-            //cout << findFunctionProcedureCall(result[line], symbolTable.table) << endl;
-            //cout << "Possible name: " << result[line][1].character << " on line " << line << endl;
+    for (const Statement<Cursor>& statement : statements) {
+        getLine(statement, line);
+        findFunctionProcedureCall(line, symbolTable.table);
+            //listOfProFuncs.push_back(line[1]);
+            //cout << findFunctionProcedureCall(line, symbolTable.table) << endl;
+            //cout << "Possible name: " << line[1].character << endl;
         
     
         
@@ -201,28 +211,33 @@ AbstractSyntaxTree::AbstractSyntaxTree(RecursiveDescentParser concreteSyntaxTree
 
 
 
-    LCRS *ast = nullptr; // new LCRS(result[0]);
+    LCRS *ast = nullptr; // new LCRS(line);
     LCRS *temp = ast;
 
     vector<vector<Token>> abstract;
 
-    for (int i = 0; i < result.size(); i++)
+    // tokens only point at their text, so text made up here (the "For 
+    // Expression" labels) is kept alive until abstract is printed
+    list<string> labels;
+
+    for (const Statement<Cursor>& statement : statements)
     {
+        getLine(statement, line);
         vector<Token> k;
         bool isDeclaration = false;
-        for (int j = 0; j < result[i].size(); j++)
+        for (int j = 0; j < line.size(); j++)
         {
             Token token;
             //finds Procedure calls
-            if (find(listOfProFuncs.begin(), listOfProFuncs.end(), result[i][0].character) != listOfProFuncs.end()){
-                //cout << "Found " << result[i][0].character << endl;
+            if (find(listOfProFuncs.begin(), listOfProFuncs.end(), line[0].symbol) != listOfProFuncs.end()){
+                //cout << "Found " << line[0].character << endl;
                 Token callToken;
                 callToken.character = "Call";
-                callToken.lineNumber = result[i][0].lineNumber;
-                callToken.type = result[i][0].type;
-                //result[i][0].character = "Call";
+                callToken.offset = line[0].offset;
+                callToken.type = line[0].type;
+                //line[0].character = "Call";
                 //cout << "test1" << endl;
-                vector<Token> postfix = infixToPostfix(result[i]);
+                vector<Token> postfix = infixToPostfix(line);
                 k.push_back(callToken);
                 //cout << "test2" << endl;
                 for (int index = 0; index < postfix.size(); index++){
@@ -235,9 +250,9 @@ AbstractSyntaxTree::AbstractSyntaxTree(RecursiveDescentParser concreteSyntaxTree
                 {
                     /*
                     int closingParenIndex = 0;
-                    for (int j = foundFunctionProcedureCall + 1; j < result[i].size() && result[i][j].character != ")"; j++) {
+                    for (int j = foundFunctionProcedureCall + 1; j < line.size() && line[j].character != ")"; j++) {
                         closingParenIndex++;
-                        cout << result[i][j].character << " ###\n";
+                        cout << line[j].character << " ###\n";
                     }
                     
 
@@ -245,7 +260,7 @@ AbstractSyntaxTree::AbstractSyntaxTree(RecursiveDescentParser concreteSyntaxTree
                     */
 
                     int numberOfParams = findNumberOfParams(
-                        result[i][foundFunctionProcedureCall].character, symbolTable.paramTable);
+                        line[foundFunctionProcedureCall].symbol, symbolTable.paramTable);
                     
                     //cout << "num params: " << numberOfParams << '\n';
                     
@@ -261,23 +276,23 @@ AbstractSyntaxTree::AbstractSyntaxTree(RecursiveDescentParser concreteSyntaxTree
                 break;
             }
 
-            if (isDeclarationKeyword(result[i][0].character))
+            if (isDeclarationKeyword(line[0].type))
             {
                 int numDeclarations = 1;
-                if (result[i][0].character == "int" ||
-                    result[i][0].character == "char" ||
-                    result[i][0].character == "bool")
+                if (line[0].type == KEYWORD_INT ||
+                    line[0].type == CHAR ||
+                    line[0].type == KEYWORD_BOOL)
                 {
-                    for (int j = 1; j < result[i].size(); j++)
+                    for (int j = 1; j < line.size(); j++)
                     {
-                        if (result[i][j].character == ",")
+                        if (line[j].character == ",")
                             numDeclarations++;
                     }
                 }
                 Token declarationToken;
                 declarationToken.character = "Declaration";
-                declarationToken.type = result[i][0].type;
-                declarationToken.lineNumber = result[i][0].lineNumber;
+                declarationToken.type = line[0].type;
+                declarationToken.offset = line[0].offset;
 
                 if (numDeclarations > 1)
                 {
@@ -316,7 +331,7 @@ AbstractSyntaxTree::AbstractSyntaxTree(RecursiveDescentParser concreteSyntaxTree
 
             /*
             // Check if the current token is "if" and the next token is also "if"
-            if (result[i][j].character == "If" && j + 1 < result[i].size() && result[i][j + 1].character == "if")
+            if (line[j].character == "If" && j + 1 < line.size() && line[j + 1].character == "if")
             {
                 continue;
             }
@@ -325,14 +340,14 @@ AbstractSyntaxTree::AbstractSyntaxTree(RecursiveDescentParser concreteSyntaxTree
 
 
             // if statement
-            if (result[i][0].character == "if")
+            if (line[0].type == KEYWORD_IF)
             {
                 // token.character = "IF";
-                // token.type = result[i][0].type;
-                // token.lineNumber = result[i][0].lineNumber;
+                // token.type = line[0].type;
+                // token.offset = line[0].offset;
                 // k.push_back(token);
 
-                vector<Token> postfix = infixToPostfix(result[i]);
+                vector<Token> postfix = infixToPostfix(line);
                 for (int r = 0; r < postfix.size(); r++)
                 {
                     k.push_back(postfix[r]);
@@ -346,9 +361,9 @@ AbstractSyntaxTree::AbstractSyntaxTree(RecursiveDescentParser concreteSyntaxTree
                 {
                     /*
                     int closingParenIndex = 0;
-                    for (int j = foundFunctionProcedureCall + 1; j < result[i].size() && result[i][j].character != ")"; j++) {
+                    for (int j = foundFunctionProcedureCall + 1; j < line.size() && line[j].character != ")"; j++) {
                         closingParenIndex++;
-                        cout << result[i][j].character << " ###\n";
+                        cout << line[j].character << " ###\n";
                     }
                     
 
@@ -356,7 +371,7 @@ AbstractSyntaxTree::AbstractSyntaxTree(RecursiveDescentParser concreteSyntaxTree
                     */
 
                     int numberOfParams = findNumberOfParams(
-                        result[i][foundFunctionProcedureCall].character, symbolTable.paramTable);
+                        line[foundFunctionProcedureCall].symbol, symbolTable.paramTable);
                     
                     //cout << "num params: " << numberOfParams << '\n';
                     
@@ -372,7 +387,7 @@ AbstractSyntaxTree::AbstractSyntaxTree(RecursiveDescentParser concreteSyntaxTree
                 break;
             }
 
-            if (result[i][0].character == "for")
+            if (line[0].type == KEYWORD_FOR)
             {
                 vector<Token> postfix;
                 vector<Token> proxyVector;
@@ -380,24 +395,25 @@ AbstractSyntaxTree::AbstractSyntaxTree(RecursiveDescentParser concreteSyntaxTree
                 int count = 1;
 
                 Token proxyToken;
-                proxyToken.character = "For Expression " + to_string(count);
-                proxyToken.type = result[i][0].type;
+                labels.push_back("For Expression " + to_string(count));
+                proxyToken.character = labels.back();
+                proxyToken.type = line[0].type;
                 proxyVector.push_back(proxyToken);
 
                 Token proxyTokenTwo;
                 proxyTokenTwo.character = "\n";
-                proxyTokenTwo.type = result[i][0].type;
+                proxyTokenTwo.type = line[0].type;
                 
-                result[i].push_back(proxyTokenTwo);                
+                line.push_back(proxyTokenTwo);                
                               
-                for (int r = 2; r < result[i].size(); r++)
+                for (int r = 2; r < line.size(); r++)
                 {
 
-                    proxyVector.push_back(result[i][r]);
+                    proxyVector.push_back(line[r]);
 
-                    if (result[i][r].character == ";" || result[i][r].character == "\n")
+                    if (line[r].character == ";" || line[r].character == "\n")
                     {
-                        if(result[i][r].character == "\n"){
+                        if(line[r].character == "\n"){
                             
                             proxyVector.pop_back();                          
                             proxyVector.pop_back();
@@ -412,14 +428,15 @@ AbstractSyntaxTree::AbstractSyntaxTree(RecursiveDescentParser concreteSyntaxTree
                             
                         }
                         
-                        if(result[i][r].character != "\n"){
+                        if(line[r].character != "\n"){
                         abstract.push_back(k);
                         
                     
                         k.clear();
                         proxyVector.clear();
                         count++;
-                        proxyToken.character = "For Expression " + to_string(count);
+                        labels.push_back("For Expression " + to_string(count));
+                        proxyToken.character = labels.back();
                         proxyVector.push_back(proxyToken);
                         }
                     }
@@ -429,14 +446,14 @@ AbstractSyntaxTree::AbstractSyntaxTree(RecursiveDescentParser concreteSyntaxTree
             }
 
             // just placing this in to start while condition
-            if (result[i][0].character == "while")
+            if (line[0].type == KEYWORD_WHILE)
             {
                 // token.character = "IF";
-                // token.type = result[i][0].type;
-                // token.lineNumber = result[i][0].lineNumber;
+                // token.type = line[0].type;
+                // token.offset = line[0].offset;
                 // k.push_back(token);
 
-                vector<Token> postfix = infixToPostfix(result[i]);
+                vector<Token> postfix = infixToPostfix(line);
                 for (int r = 0; r < postfix.size(); r++)
                 {
                     k.push_back(postfix[r]);
@@ -445,29 +462,30 @@ AbstractSyntaxTree::AbstractSyntaxTree(RecursiveDescentParser concreteSyntaxTree
                 break;
             }
 
-            if (result[i][0].character == "{")
+            if (line[0].character == "{")
             {
-                result[i][0].character = "Begin Block";
-                k.push_back(result[i][0]);
+                line[0].character = "Begin Block";
+                k.push_back(line[0]);
                 break;
             }
 
-            if (result[i][0].character == "}")
+            if (line[0].character == "}")
             {
-                result[i][0].character = "End Block";
-                k.push_back(result[i][0]);
+                line[0].character = "End Block";
+                k.push_back(line[0]);
                 break;
             }
 
-            if (result[i][1].character == "=" || result[i][4].character == "=")
+            if ((line.size() > 1 && line[1].character == "=") ||
+                (line.size() > 4 && line[4].character == "="))
             {
                 
                 token.character = "Assignment";
-                token.type = result[i][0].type;
-                token.lineNumber = result[i][0].lineNumber;
+                token.type = line[0].type;
+                token.offset = line[0].offset;
                 k.push_back(token);
 
-                vector<Token> postfix = infixToPostfix(result[i]);
+                vector<Token> postfix = infixToPostfix(line);
                 for (int r = 0; r < postfix.size(); r++)
                 {
                     k.push_back(postfix[r]);
@@ -478,13 +496,13 @@ AbstractSyntaxTree::AbstractSyntaxTree(RecursiveDescentParser concreteSyntaxTree
                 if (foundFunctionProcedureCall != -1)
                 {
                     int closingParenIndex = 0;
-                    for (int j = foundFunctionProcedureCall + 2; j < result[i].size() && result[i][j].character != ")"; j++) {
+                    for (int j = foundFunctionProcedureCall + 2; j < line.size() && line[j].character != ")"; j++) {
                         closingParenIndex++;
                     }
 
                     /*
                     int numberOfParams = findNumberOfParams(
-                        result[i][foundFunctionProcedureCall].character, symbolTable.paramTable);
+                        line[foundFunctionProcedureCall].symbol, symbolTable.paramTable);
                     */
                     // cout << "num params: " << numberOfParams << '\n';
                     token.character = "(";
@@ -499,9 +517,9 @@ AbstractSyntaxTree::AbstractSyntaxTree(RecursiveDescentParser concreteSyntaxTree
             }
 
             // print statement
-            if (result[i][0].character == "printf")
+            if (line[0].type == KEYWORD_PRINTF)
             {
-                vector<Token> postfix = infixToPostfix(result[i]);
+                vector<Token> postfix = infixToPostfix(line);
                 for (int r = 0; r < postfix.size(); r++)
                 {
                     if (postfix[r].character != "\"")
@@ -513,16 +531,16 @@ AbstractSyntaxTree::AbstractSyntaxTree(RecursiveDescentParser concreteSyntaxTree
             }
 
             // new semicolon work
-            if (result[i][result[i].size() - 1].character == ";")
+            if (line[line.size() - 1].character == ";")
             {
                 /*
                 token.character = "Semicolon";
-                token.type = result[i][0].type;
-                token.lineNumber = result[i][0].lineNumber;
+                token.type = line[0].type;
+                token.offset = line[0].offset;
                 k.push_back(token);
                 */
 
-                vector<Token> postfix = infixToPostfix(result[i]);
+                vector<Token> postfix = infixToPostfix(line);
                 for (int r = 0; r < postfix.size(); r++)
                 {
                     k.push_back(postfix[r]);
@@ -530,9 +548,9 @@ AbstractSyntaxTree::AbstractSyntaxTree(RecursiveDescentParser concreteSyntaxTree
                 break;
             }
 
-            token.character = result[i][j].character;
-            token.type = result[i][j].type;
-            token.lineNumber = result[i][j].lineNumber;
+            token.character = line[j].character;
+            token.type = line[j].type;
+            token.offset = line[j].offset;
             k.push_back(token);
         }
         abstract.push_back(k);
@@ -559,6 +577,5 @@ AbstractSyntaxTree::AbstractSyntaxTree(RecursiveDescentParser concreteSyntaxTree
  */
 ostream &operator<<(ostream &os, const AbstractSyntaxTree &obj)
 {
-    os << obj.abstractSyntaxTree->BFS();
-    return os;
+    return printLevelOrder(os, LCRSCursor(obj.abstractSyntaxTree));
 }
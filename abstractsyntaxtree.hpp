@@ -8,6 +8,7 @@
 #include "Tokenization.hpp" // Include the header where Token is defined
 #include "symboltable.hpp"
 #include "RecursiveDescentParser.hpp"
+#include "CompactTree.hpp"
 
 using namespace std;
 
@@ -30,13 +31,16 @@ public:
      * @param concreteSyntaxTree - The concrete syntax tree that was generated in
      *                                                      RecursiveDescentParser
      */
-    AbstractSyntaxTree(RecursiveDescentParser concreteSyntaxTree, SymbolTable symbolTable);
+    AbstractSyntaxTree(const RecursiveDescentParser& concreteSyntaxTree, 
+                       const SymbolTable& symbolTable);
 
     /**
-     * @brief Constructor
-     * @param tokens - A vector of tokens from a C-style program
+     * @brief Constructs AbstractSyntaxTree object
+     * @param concreteSyntaxTree - The compact CST of the program
+     * @param symbolTable - The symbol table built from the same CST
      */
-    AbstractSyntaxTree(const vector<Token> &tokens);
+    AbstractSyntaxTree(const CompactTree& concreteSyntaxTree, 
+                       const SymbolTable& symbolTable);
 
     /**
      * @brief Output operator overload
@@ -50,15 +54,21 @@ public:
     friend ostream &operator<<(ostream &os, const AbstractSyntaxTree &obj);
 
 private:
+
+    // builds the AST from any tree that has a cursor (see TreeCursor.hpp)
+    template <typename Cursor>
+    void build(const StatementTable<Cursor>& statements, 
+               const SymbolTable& symbolTable);
+
     LCRS *abstractSyntaxTree;
 
-    vector<string>listOfProFuncs;
+    vector<SymbolId>listOfProFuncs;
 
 
-    bool isDeclarationKeyword(const string &tokenCharacter)
+    bool isDeclarationKeyword(TokenType tokenType)
     {
-        return (tokenCharacter == "function" || tokenCharacter == "procedure" ||
-                tokenCharacter == "int" || tokenCharacter == "char" || tokenCharacter == "bool" );
+        return (tokenType == KEYWORD_FUNCTION || tokenType == KEYWORD_PROCEDURE ||
+                tokenType == KEYWORD_INT || tokenType == CHAR || tokenType == KEYWORD_BOOL);
     }
 
     int precedence(const Token &token)
@@ -93,7 +103,7 @@ private:
 
         for (const Token &token : infix)
         {
-            if (token.type == INTEGER || token.type == IDENTIFIER ||
+            if (token.type == INTEGER || isWord(token.type) ||
                 token.type == STRING || token.type == SINGLE_QUOTE ||
                 token.type == LEFT_BRACKET || token.type == RIGHT_BRACKET || token.type == DOUBLE_QUOTE)
             {
@@ -196,18 +206,18 @@ private:
     // finds if a line contains a function/procedure call from symbol table
     // returns -1 if no function/procedure call found in line, otherwise
     // returns the index of function/procedure call was
-    int findFunctionProcedureCall(const vector<Token> &line, const list<TableEntry> &symbolTable)
+    int findFunctionProcedureCall(const vector<Token> &line, const vector<TableEntry> &symbolTable)
     {
         for (int i = 0; i < line.size(); i++)
         {
             for (const auto &symbol : symbolTable)
             {
-                if (symbol.identifierName == line[i].character &&
+                if (symbol.identifier == line[i].symbol &&
                     (symbol.identifierType == "function" || symbol.identifierType == "procedure"))
                 {
                      //creates a list of function and procedure names
-                     if(!count(listOfProFuncs.begin(), listOfProFuncs.end(), line[i].character)){
-                        listOfProFuncs.push_back(line[i].character);
+                     if(!count(listOfProFuncs.begin(), listOfProFuncs.end(), line[i].symbol)){
+                        listOfProFuncs.push_back(line[i].symbol);
                      }
                      //cout << "Found: " << line[i].character << " at index " << i << endl;
                      
@@ -221,12 +231,12 @@ private:
         return -1;
     }
 
-    int findNumberOfParams(const string &functionName, const list<ParamListEntry> &paramTable)
+    int findNumberOfParams(SymbolId functionName, const vector<ParamListEntry> &paramTable)
     {
         int numberOfParams = 0;
         for (const auto &param : paramTable)
         {
-            if (functionName == param.paramListName)
+            if (functionName == param.paramList)
             {
                 numberOfParams++;
             }
@@ -6,55 +6,257 @@
 
 #include "IgnoreComments.hpp"
 #include "Tokenization.hpp"
+#include "IdentifierTable.hpp"
 #include "RecursiveDescentParser.hpp"
+#include "CompactTree.hpp"
+#include "PredictiveParser.hpp"
 #include "symboltable.hpp"
 #include "abstractsyntaxtree.hpp"
+#include "Pipeline.hpp"
+#include "SourceBatch.hpp"
+#include "Diagnostic.hpp"
+#include "Session.hpp"
+#include "TokenCache.hpp"
 #include "infixtopostfix.cpp"
+#include <fstream>
 #include <iostream>
-#include <sstream>
+#include <thread>
 
 using namespace std;
 
+/**
+ * @struct Options
+ * @brief How main runs the stages, set by the flags before the file names
+ */
+struct Options {
+    // run lexing, parsing and the symbol table on separate threads
+    bool pipelined = false;
+    // more than one to lex each program and build its CST in chunks on 
+    // that many threads
+    unsigned lexThreads = 1;
+    // go on to the next program after one is rejected
+    bool keepGoing = false;
+    // write the tokens of each program to a token cache next to it
+    bool saveTokens = false;
+    // print the typed syntax tree instead of the AST
+    bool syntaxTree = false;
+};
+
+/**
+ * @brief Builds the symbol table and prints the AST for a parsed program
+ * @param recursiveDescentParser - The CST of the program
+ * @param diagnostic - Receives the error the program was rejected for
+ * @returns False if the symbol table rejected the program
+ */
+static bool analyzeConcreteSyntaxTree(
+        const RecursiveDescentParser& recursiveDescentParser, 
+        Diagnostic& diagnostic) {
+    SymbolTable symbolTable(recursiveDescentParser);
+
+    if (symbolTable.hasError()) {
+        diagnostic = symbolTable.getDiagnostic();
+        return false;
+    }
+
+    AbstractSyntaxTree abstractSyntaxTree(recursiveDescentParser, symbolTable);
+    return true;
+}
+
+/**
+ * @brief Runs every stage on one program and prints the AST
+ * @param source - A C-style program that may still contain comments, or a
+ *                 token cache of one
+ * @param fileName - The name source was loaded from
+ * @param options - How to run the stages
+ * @param session - Runs the stages when nothing else is asked for, reusing
+ *                  the memory of the programs before this one
+ * @param diagnostic - Receives the error the program was rejected for
+ * @returns False if a stage rejected the program, in which case nothing is
+ *          printed
+ */
+static bool analyze(const SourceBuffer& source, const string& fileName,
+                    const Options& options, Session& session, 
+                    Diagnostic& diagnostic) {
+    if (!source.isOpen()) {
+        cerr << "Error. Unable to open the file :( \n";
+    }
+
+    // names are only compared within a program, so each program starts 
+    // with an empty identifier table instead of one holding every name seen
+    // so far
+    IdentifierTable::get().reset();
+
+    // cached tokens are parsed straight from the cache, so comments are not
+    // stripped and nothing is lexed
+    if (isTokenCache(source.data(), source.size())) {
+        TokenCacheReader reader(source.data(), source.size());
+        RecursiveDescentParser recursiveDescentParser(reader);
+
+        if (reader.hasError()) {
+            diagnostic = Diagnostic{DIAGNOSTIC_DAMAGED_TOKEN_CACHE, 0, 
+                                    "the token cache is damaged."};
+            return false;
+        }
+
+        return analyzeConcreteSyntaxTree(recursiveDescentParser, diagnostic);
+    }
+
+    // the syntax tree replaces the AST, so it wins over the ways of building
+    // the AST below
+    if (options.syntaxTree) {
+        Tokenization tokenization(source, options.lexThreads);
+
+        if (tokenization.hasError()) {
+            diagnostic = tokenization.getDiagnostic();
+            return false;
+        }
+
+        PredictiveParser predictiveParser(tokenization.getTokens());
+
+        if (predictiveParser.hasError()) {
+            diagnostic = predictiveParser.getDiagnostic();
+            return false;
+        }
+
+        // the grammar does not know about redefined variables, so the 
+        // program still goes through the symbol table, built from a CST of
+        // the same tokens
+        CompactTree concreteSyntaxTree(tokenization.getTokens(), 
+                                       options.lexThreads);
+        SymbolTable symbolTable(concreteSyntaxTree);
+
+        if (symbolTable.hasError()) {
+            diagnostic = symbolTable.getDiagnostic();
+            return false;
+        }
+
+        cout << predictiveParser;
+        return true;
+    }
+
+    if (options.pipelined) {
+        Pipeline pipeline(source);
+
+        if (pipeline.hasError()) {
+            diagnostic = pipeline.getDiagnostic();
+            return false;
+        }
+
+        AbstractSyntaxTree abstractSyntaxTree(pipeline.getParser(), 
+                                              pipeline.getSymbolTable());
+        return true;
+    }
+
+    if (options.lexThreads > 1 || options.saveTokens) {
+        Tokenization tokenization(source, options.lexThreads);
+
+        if (tokenization.hasError()) {
+            diagnostic = tokenization.getDiagnostic();
+            return false;
+        }
+
+        if (options.saveTokens) {
+            ofstream cache(fileName + ".tok", ios::binary);
+            writeTokenCache(cache, tokenization.getTokens());
+        }
+
+        // the whole program is already in memory, so the CST is built in one
+        // array instead of node by node, split between top-level 
+        // declarations
+        CompactTree concreteSyntaxTree(tokenization.getTokens(), 
+                                       options.lexThreads);
+        SymbolTable symbolTable(concreteSyntaxTree);
+
+        if (symbolTable.hasError()) {
+            diagnostic = symbolTable.getDiagnostic();
+            return false;
+        }
+
+        AbstractSyntaxTree abstractSyntaxTree(concreteSyntaxTree, symbolTable);
+        return true;
+    }
+
+    // outputs the input program without comments
+    // cout << IgnoreComments(source.data(), source.size()) << '\n'; 
+
+    // outputs tokens according to project 2 spec
+    // cout << Tokenization(source) << '\n';
+
+    return session.analyze(source, diagnostic);
+}
+
 int main(int argc, char *argv[]) {
-    if (argc != 2 ) {
+    Options options;
+    int firstFile = 1;
+
+    for (; firstFile < argc; firstFile++) {
+        string flag = argv[firstFile];
+
+        // --pipeline runs lexing, parsing and the symbol table on separate 
+        // threads, which pays off for a single large program
+        if (flag == "--pipeline")
+            options.pipelined = true;
+        // --parallel lexes a large program and builds its CST in chunks, 
+        // one per core
+        else if (flag == "--parallel")
+            options.lexThreads = max(1u, thread::hardware_concurrency());
+        // --keep-going goes on to the next program after one is rejected,
+        // instead of stopping there
+        else if (flag == "--keep-going")
+            options.keepGoing = true;
+        // --save-tokens caches the tokens of each program in a .tok file 
+        // next to it, which can be analyzed in its place later
+        else if (flag == "--save-tokens")
+            options.saveTokens = true;
+        // --syntax-tree parses each program by its grammar and prints the
+        // typed syntax tree instead of the AST, even with --pipeline; token
+        // caches are analyzed as usual
+        else if (flag == "--syntax-tree")
+            options.syntaxTree = true;
+        else
+            break;
+    }
+
+    if (argc <= firstFile) {
         cerr << "Error! There is not a correct number of command line arguments.\n";
         return 1;
     }
 
-    string fileName = argv[1];
-    IgnoreComments ignoreComments(fileName);
+    Session session;
+    Diagnostic diagnostic;
 
-    // outputs the input program without comments
-    // cout << ignoreComments << '\n'; 
+    if (argc == firstFile + 1) {
+        SourceBuffer source(argv[firstFile]);
 
-    // converting the output stream to a string for Tokenization constructor
-    stringstream ss;
-    ss << ignoreComments;
-    Tokenization tokenization(ss.str());
-    vector<Token> tokens = tokenization.getTokens();
+        if (!analyze(source, argv[firstFile], options, session, diagnostic)) {
+            printDiagnostic(diagnostic);
+            return getExitStatus(diagnostic);
+        }
 
-    // outputs tokens according to project 2 spec
-    // cout << tokenization << '\n';
-
-    //SymbolTable symbolTable;
-    //symbolTable.populateSymbolTable(tokens);
-    // Print the symbol table
-    //symbolTable.print();
-        
-    RecursiveDescentParser recursiveDescentParser(tokens);
-    // cout << recursiveDescentParser;
-
-    // converting the output stream to a string for SymbolTable constructor
-    /*
-    stringstream ss2;
-    ss2 << recursiveDescentParser;
-    */
-    SymbolTable symbolTable(recursiveDescentParser);
-    // cout << symbolTable;
+        return 0;
+    }
 
-    AbstractSyntaxTree abstractSyntaxTree(recursiveDescentParser, symbolTable);
-    //cout << abstractSyntaxTree;
-    
+    // with many programs, loading them is batched and happens in the 
+    // background while the earlier ones are analyzed
+    SourceBatch batch(vector<string>(argv + firstFile, argv + argc));
+    int status = 0;
+
+    for (size_t i = 0; i < batch.size(); i++) {
+        // each program is freed as soon as it has been analyzed
+        unique_ptr<SourceBuffer> source = batch.take(i);
+
+        if (analyze(*source, argv[firstFile + i], options, session,
+                    diagnostic))
+            continue;
+
+        printDiagnostic(diagnostic);
+
+        if (!options.keepGoing)
+            return getExitStatus(diagnostic);
+
+        // the run fails if any program failed
+        status = max(status, getExitStatus(diagnostic));
+    }
 
-    return 0;
-}
\ No newline at end of file
+    return status;
+}
@@ -1,170 +1,237 @@
 #include "symboltable.hpp"
 #include <string>
-#include <sstream>
-#include <cassert>
+#include "TreeCursor.hpp"
+
+/**
+ * @brief Moves a cursor right past count siblings
+ * @param node - The node to start at
+ * @param count - The number of siblings to move past
+ * @returns The node count siblings to the right, or no node if the 
+ *          statement ends first
+ */
+template <typename Cursor>
+static Cursor skipSiblings(Cursor node, int count) {
+    while (node && count-- > 0)
+        node = node.rightSibling();
+
+    return node;
+}
 
 /**
  * @brief Constructs SymbolTable object
  * @param concreteSyntaxTree - The concrete syntax tree that was generated in
  *                                                      RecursiveDescentParser
  */
-SymbolTable::SymbolTable(RecursiveDescentParser concreteSyntaxTree) {
-    // converts concreteSyntaxTree to string
-    stringstream ss;
-    ss << concreteSyntaxTree;
-    string cst = ss.str();
-
-    // makes 2d vector of strings from the cst string
-    //
-    // outter vector is vector of vectors where each inner vector represents one
-    // line from the cst string
-    //
-    // inner vector has each word from that line
-    vector<vector<string>> linesAndWords;
-    string line;
-
-    while (getline(ss, line)) {
-        istringstream lineStream(line);
-        vector<string> words;
-        string word;
-
-        while (lineStream >> word) {
-            words.push_back(word);
-        }
+SymbolTable::SymbolTable(const RecursiveDescentParser& concreteSyntaxTree) 
+    : SymbolTable(concreteSyntaxTree.getLineIndex()) {
+    addStatements(concreteSyntaxTree.getStatements());
+}
+
+/**
+ * @brief Constructs an empty SymbolTable object, for statements that are 
+ *        added one at a time as the parser finishes them
+ * @param lineIndex - The line index of the program, used for line numbers in
+ *                    errors
+ */
+SymbolTable::SymbolTable(const LineIndex& lineIndex) 
+    : lineIndex(&lineIndex), failed(false), scope(1) { }
+
+/**
+ * @brief Constructs SymbolTable object
+ * @param concreteSyntaxTree - The compact CST of the program
+ */
+SymbolTable::SymbolTable(const CompactTree& concreteSyntaxTree) 
+    : SymbolTable(concreteSyntaxTree.getTokens().getLineIndex()) {
+    addStatements(concreteSyntaxTree.getStatements());
+}
+
+/**
+ * @brief Empties the table, keeping its memory, and builds it again from 
+ *        another CST
+ * @param concreteSyntaxTree - The concrete syntax tree that was generated in
+ *                                                      RecursiveDescentParser
+ */
+void SymbolTable::reset(const RecursiveDescentParser& concreteSyntaxTree) {
+    table.clear();
+    paramTable.clear();
+    lineIndex = &concreteSyntaxTree.getLineIndex();
+    failed = false;
+    scope = 1;
+    addStatements(concreteSyntaxTree.getStatements());
+}
 
-        linesAndWords.push_back(words);
+/**
+ * @brief Adds every statement of a CST
+ * @param statements - The statement table of the CST
+ */
+template <typename Cursor>
+void SymbolTable::addStatements(const StatementTable<Cursor>& statements) {
+    for (const Statement<Cursor>& statement : statements) {
+        if (failed)
+            break;
+
+        addCursorStatement(statement);
     }
+}
 
-    LCRS *lcrs = concreteSyntaxTree.getConcreteSyntaxTree();
-    vector<string> slice;
-    // used to keep track of when a new scope is neccesary -- when to scope++
-    int leftBraceCounter = 0;
-    int scope = 1;
-    for (int i = 0; i < linesAndWords.size(); i++) {
-        int lineNumber = lcrs->token.lineNumber;
-        TableEntry tableEntry;
-        StateDFA state = linesAndWords[i][0] == "function" ? FUNCTION : 
-                         linesAndWords[i][0] == "procedure"  ? PROCEDURE : 
-                        (linesAndWords[i][0] == "int" || 
-                         linesAndWords[i][0] == "char" ||
-                         linesAndWords[i][0] == "bool") ? 
-                         VARIABLE : OTHER_STATE;
-
-        switch (state) {
-            case FUNCTION:
-                tableEntry.identifierName = linesAndWords[i][2];
-                tableEntry.identifierType = linesAndWords[i][0];
-                tableEntry.datatype = linesAndWords[i][1];
-                tableEntry.datatypeIsArray = false;
-                tableEntry.datatypeArraySize = 0;
-                tableEntry.scope = scope;
-                table.push_back(tableEntry);
-                assert(linesAndWords[i][3] == "(");
-                slice.assign(linesAndWords[i].begin() + 4, linesAndWords[i].end());
-                parseParams(slice, scope, tableEntry.identifierName);
-                break;
-            case PROCEDURE:
-                tableEntry.identifierName = linesAndWords[i][1];
-                tableEntry.identifierType = linesAndWords[i][0];
-                tableEntry.datatype = "NOT APPLICABLE";
+/**
+ * @brief Adds the symbols declared by one statement of the CST
+ * @param statement - A complete statement from the parser's statement table
+ */
+void SymbolTable::addStatement(const Statement<LCRSCursor>& statement) {
+    addCursorStatement(statement);
+}
+
+/**
+ * @brief Adds the symbols declared by one statement of any CST
+ * @param statement - A complete statement from the CST's statement table
+ */
+template <typename Cursor>
+void SymbolTable::addCursorStatement(const Statement<Cursor>& statement) {
+    if (failed)
+        return;
+
+    switch (statement.kind) {
+        case STATEMENT_FUNCTION_DECLARATION:
+        case STATEMENT_PROCEDURE_DECLARATION:
+            break;
+
+        // string variables have never been added to the table
+        case STATEMENT_VARIABLE_DECLARATION:
+            if (statement.first.token().type == KEYWORD_STRING)
+                return;
+            break;
+
+        case STATEMENT_BLOCK_END:
+            if (statement.depth == 0)
+                scope++;
+            return;
+
+        default:
+            return;
+    }
+
+    Cursor node = statement.first;
+    TableEntry tableEntry;
+
+    switch (statement.kind) {
+        case STATEMENT_FUNCTION_DECLARATION:
+        case STATEMENT_PROCEDURE_DECLARATION: {
+            // function <datatype> <name> ( or procedure <name> (
+            tableEntry.identifierType = string(node.token().character);
+            tableEntry.datatype = "NOT APPLICABLE";
+            node = node.rightSibling();
+
+            if (statement.kind == STATEMENT_FUNCTION_DECLARATION && node) {
+                tableEntry.datatype = string(node.token().character);
+                node = node.rightSibling();
+            }
+
+            Cursor leftParenthesis = skipSiblings(node, 1);
+
+            // a declaration cut off by the end of the program declares 
+            // nothing
+            if (!leftParenthesis || 
+                leftParenthesis.token().type != LEFT_PARENTHESIS)
+                return;
+
+            tableEntry.identifier = node.token().symbol;
+            tableEntry.datatypeIsArray = false;
+            tableEntry.datatypeArraySize = 0;
+            tableEntry.scope = scope;
+            table.push_back(tableEntry);
+            addParams(leftParenthesis.rightSibling(), scope, 
+                      tableEntry.identifier);
+            break;
+        }
+        case STATEMENT_VARIABLE_DECLARATION:
+            tableEntry.identifierType = "datatype";
+            tableEntry.datatype = string(node.token().character);
+            tableEntry.scope = statement.depth == 0 ? 0 : scope;
+            node = node.rightSibling();
+
+            // <name> , or <name> [ <size> ] , up to the ;
+            while (node && node.token().type != SEMICOLON) {
+                const Token& name = node.token();
+                Cursor next = node.rightSibling();
+                tableEntry.identifier = name.symbol;
                 tableEntry.datatypeIsArray = false;
                 tableEntry.datatypeArraySize = 0;
-                tableEntry.scope = scope;
-                table.push_back(tableEntry);
-                assert(linesAndWords[i][2] == "(");
-                slice.assign(linesAndWords[i].begin() + 3, linesAndWords[i].end());
-                parseParams(slice, scope, tableEntry.identifierName);
-                break;
-            case VARIABLE:
-                tableEntry.identifierType = "datatype";
-                tableEntry.datatype = linesAndWords[i][0];
-                tableEntry.scope = leftBraceCounter == 0 ? 0 : scope;
 
-                for (int j = 1; j < linesAndWords[i].size();) {
-                    if (linesAndWords[i][j] == ";")
+                if (next && next.token().type == LEFT_BRACKET) {
+                    Cursor size = next.rightSibling();
+
+                    if (!size)
                         break;
-                    tableEntry.identifierName = linesAndWords[i][j];
-                    tableEntry.datatypeIsArray = false;
-                    tableEntry.datatypeArraySize = 0;
-
-                    // array
-                    if (linesAndWords[i][j + 1] == "[") {
-                        tableEntry.datatypeIsArray = true;
-                        tableEntry.datatypeArraySize = stoi(linesAndWords[i][j + 2]);
-                        
-                        for (const auto& symbol : table) {
-                            if (symbol.identifierName == tableEntry.identifierName&&
-                                (symbol.scope == 0 || symbol.scope == tableEntry.scope)) {
-                                string globallyLocally = symbol.scope == 0 ? 
-                                                "globally" : "locally";
-                                cerr << "Error on line " << lineNumber << ": variable \""
-                                    << tableEntry.identifierName << "\" is already "
-                                    << "defined " << globallyLocally << '\n';
-                                exit(0);
-                            }
-                        }
-
-                        for (const auto& symbol : paramTable) {
-                            if (symbol.identifierName == tableEntry.identifierName &&
-                                symbol.scope == tableEntry.scope) {
-                                cerr << "Error on line " << lineNumber << ": variable \""
-                                    << tableEntry.identifierName << "\" is already "
-                                    << "defined locally\n";
-                                exit(0);
-                            }
-                        }
-
-                        table.push_back(tableEntry);
-                        j += 5;
-                    } else {
-
-                        for (const auto& symbol : table) {
-                            if (symbol.identifierName == tableEntry.identifierName &&
-                                (symbol.scope == 0 || symbol.scope == tableEntry.scope)) {
-                                string globallyLocally = symbol.scope == 0 ? 
-                                                "globally" : "locally";
-                                cerr << "Error on line " << lineNumber << ": variable \""
-                                    << tableEntry.identifierName << "\" is already "
-                                    << "defined " << globallyLocally << '\n';
-                                exit(0);
-                            }
-                        }
-
-                        for (const auto& symbol : paramTable) {
-                            if (symbol.identifierName == tableEntry.identifierName &&
-                                symbol.scope == tableEntry.scope) {
-                                cerr << "Error on line " << lineNumber << ": variable \""
-                                    << tableEntry.identifierName << "\" is already "
-                                    << "defined locally\n";
-                                exit(0);
-                            }
-                        }
-
-                        table.push_back(tableEntry);
-                        j += 2;
-                    }
+
+                    tableEntry.datatypeIsArray = true;
+                    tableEntry.datatypeArraySize = 
+                        stoi(string(size.token().character));
+                    next = skipSiblings(size, 3);
+                } else {
+                    next = skipSiblings(node, 2);
                 }
-                break;
-            case OTHER_STATE:
-                if (linesAndWords[i][0] == "{")
-                    leftBraceCounter++;
 
-                if (linesAndWords[i][0] == "}") {
-                    leftBraceCounter--;
+                for (const auto& symbol : table) {
+                    if (symbol.identifier == tableEntry.identifier &&
+                        (symbol.scope == 0 || symbol.scope == tableEntry.scope)) {
+                        string globallyLocally = symbol.scope == 0 ? 
+                                "globally" : "locally";
+                        reportError(statement.first.token(), "variable \"" +
+                                    string(name.character) + "\" is already " +
+                                    "defined " + globallyLocally);
+                        return;
+                    }
+                }
 
-                    if (leftBraceCounter == 0)
-                        scope++;
+                for (const auto& symbol : paramTable) {
+                    if (symbol.identifier == tableEntry.identifier &&
+                        symbol.scope == tableEntry.scope) {
+                        reportError(statement.first.token(), "variable \"" +
+                                    string(name.character) + "\" is already " +
+                                    "defined locally");
+                        return;
+                    }
                 }
-                break;
-        }
 
-        while (lcrs->rightSibling)
-            lcrs = lcrs->rightSibling;
-        if (lcrs->leftChild)
-            lcrs = lcrs->leftChild;
+                table.push_back(tableEntry);
+                node = next;
+            }
+            break;
+        default:
+            break;
     }
 }
 
+/**
+ * @brief Stops the symbol table on an error in a statement
+ * @param token - The first token of the statement with the error
+ * @param message - What is wrong
+ * @remark The caller returns right after, and statements added from then on
+ *         are ignored
+ */
+void SymbolTable::reportError(const Token& token, const string& message) {
+    failed = true;
+    diagnostic = Diagnostic{DIAGNOSTIC_REDEFINED_VARIABLE,
+                            lineIndex->getLineNumber(token.offset), message};
+}
+
+/**
+ * @brief Returns true if a statement redefined a variable; statements added
+ *        after that are ignored
+ */
+bool SymbolTable::hasError() const {
+    return failed;
+}
+
+/**
+ * @brief Getter for diagnostic private variable
+ * @returns The error the symbol table stopped on
+ */
+const Diagnostic& SymbolTable::getDiagnostic() const {
+    return diagnostic;
+}
+
 /**
  * @brief Output operator overload
  * @param os - The output stream operator
@@ -176,9 +243,11 @@ SymbolTable::SymbolTable(RecursiveDescentParser concreteSyntaxTree) {
  */
 ostream &operator<<(ostream &os, const SymbolTable &obj) {
     ParamListEntry previous;
+    const IdentifierTable& identifiers = IdentifierTable::get();
 
     for (const auto &entry : obj.table) {
-        os << "IDENTIFIER_NAME: " << entry.identifierName << '\n';
+        os << "IDENTIFIER_NAME: " << identifiers.getName(entry.identifier) 
+           << '\n';
         os << "IDENTIFIER_TYPE: " << entry.identifierType << '\n';
         os << "DATATYPE: " << entry.datatype << '\n';
         os << "DATATYPE_IS_ARRAY: ";
@@ -192,11 +261,13 @@ ostream &operator<<(ostream &os, const SymbolTable &obj) {
     }
 
     for (const auto &entry : obj.paramTable) {
-        if (previous.paramListName != entry.paramListName) {
-            os << "PARAMETER LIST FOR: " << entry.paramListName << '\n';
+        if (previous.paramList != entry.paramList) {
+            os << "PARAMETER LIST FOR: " 
+               << identifiers.getName(entry.paramList) << '\n';
             previous = entry;
         }
-        os << "IDENTIFIER_NAME: " << entry.identifierName << '\n';
+        os << "IDENTIFIER_NAME: " << identifiers.getName(entry.identifier) 
+           << '\n';
         os << "DATATYPE: " << entry.datatype << '\n';
         os << "DATATYPE_IS_ARRAY: ";
         if (entry.datatypeIsArray)
@@ -211,62 +282,49 @@ ostream &operator<<(ostream &os, const SymbolTable &obj) {
     return os;
 }
 
-void SymbolTable::parseParams(const vector<string> &params, int scope, 
-                                            const string &paramListName) {
-    if (params[0] == "void")
+/**
+ * @brief Adds the parameters of a function or procedure declaration
+ * @param node - The node after the declaration's (
+ * @param scope - The scope of the declaration
+ * @param paramList - The name of the function or procedure
+ */
+template <typename Cursor>
+void SymbolTable::addParams(Cursor node, int scope, SymbolId paramList) {
+    if (!node || node.token().type == VOID)
         return;
     ParamListEntry paramListEntry;
-    paramListEntry.paramListName = paramListName;
+    paramListEntry.paramList = paramList;
     paramListEntry.scope = scope;
 
-    for ( int j = 0; j < params.size(); ) {
-        if (params[j] == ")")
+    // <datatype> <name> , or <datatype> <name> [ <size> ] , up to the )
+    while (node && node.token().type != RIGHT_PARENTHESIS) {
+        Cursor name = node.rightSibling();
+
+        if (!name)
             break;
-        paramListEntry.identifierName = params[j + 1];
-        paramListEntry.datatype = params[j];
+
+        Cursor next = name.rightSibling();
+        paramListEntry.identifier = name.token().symbol;
+        paramListEntry.datatype = string(node.token().character);
         paramListEntry.datatypeIsArray = false;
         paramListEntry.datatypeArraySize = 0;
 
         // array
-        if (params[j + 2] == "[") {
+        if (next && next.token().type == LEFT_BRACKET) {
+            Cursor size = next.rightSibling();
+
+            if (!size)
+                break;
+
             paramListEntry.datatypeIsArray = true;
-            paramListEntry.datatypeArraySize = stoi(params[j + 3]);
+            paramListEntry.datatypeArraySize = 
+                stoi(string(size.token().character));
             paramTable.push_back(paramListEntry);
-            j += 6;
+            node = skipSiblings(size, 3);
         }
         else { // regular variable
             paramTable.push_back(paramListEntry);
-            j += 3;
-        }
-    }
-
-    /*
-    // Loop through the parameters
-    for (int i = 0; i < params.size(); ++i) {
-        // Skip commas
-        if (params[i] == ",")
-            continue;
-
-        // Skip the '[' character for arrays
-        if (params[i] == "[") {
-            // The array size is the next parameter
-            paramListEntry.datatypeArraySize = stoi(params[i + 1]);
-            continue;
-        }
-
-        // Skip the ']' character for arrays
-        if (params[i] == "]")
-            continue;
-
-        // Determine if the parameter is a datatype or identifier
-        if (params[i + 1] == "," || params[i + 1] == "[" || params[i + 1] == ")") {
-            // Parameter is an identifier
-            paramListEntry.identifierName = params[i];
-            paramTable.push_back(paramListEntry);
-        } else {
-            // Parameter is a datatype
-            paramListEntry.datatype = params[i];
+            node = skipSiblings(name, 2);
         }
     }
-    */
 }
@@ -3,16 +3,17 @@
 
 #include <iostream>
 #include <vector>
-#include <list>
 #include "Tokenization.hpp" // Include the header where Token is defined
 #include "RecursiveDescentParser.hpp"
+#include "CompactTree.hpp"
 
 using namespace std;
 
 struct TableEntry {
-    TableEntry() : identifierName(""), identifierType(""), datatype(""), 
+    TableEntry() : identifier(NO_SYMBOL), identifierType(""), datatype(""), 
                     datatypeIsArray(false), datatypeArraySize(0), scope(0) { }
-    string identifierName;
+    // the name, as its number in the IdentifierTable
+    SymbolId identifier;
     string identifierType;
     string datatype;
     bool datatypeIsArray;
@@ -21,24 +22,19 @@ struct TableEntry {
 };
 
 struct ParamListEntry {
-    ParamListEntry() : identifierName(""), datatype(""), 
-                       datatypeIsArray(false), datatypeArraySize(0), 
-                       scope(0) { }
-    string paramListName;
-    string identifierName;
+    ParamListEntry() : paramList(NO_SYMBOL), identifier(NO_SYMBOL), 
+                       datatype(""), datatypeIsArray(false), 
+                       datatypeArraySize(0), scope(0) { }
+    // the function or procedure's name and the parameter's name, as their
+    // numbers in the IdentifierTable
+    SymbolId paramList;
+    SymbolId identifier;
     string datatype;
     bool datatypeIsArray;
     int datatypeArraySize;
     int scope;
 };
 
-enum StateDFA {
-    OTHER_STATE,
-    FUNCTION,
-    PROCEDURE,
-    VARIABLE,
-};
-
 // Symbol table class
 class SymbolTable {
 public:
@@ -47,7 +43,48 @@ public:
      * @param cst - The string version of the concrete syntax tree that was
      *          generated in RecursiveDescentParser
      */
-    SymbolTable(RecursiveDescentParser concreteSyntaxTree);
+    SymbolTable(const RecursiveDescentParser& concreteSyntaxTree);
+
+    /**
+     * @brief Constructs an empty SymbolTable object, for statements that are
+     *        added one at a time as the parser finishes them
+     * @param lineIndex - The line index of the program, used for line 
+     *                    numbers in errors
+     */
+    explicit SymbolTable(const LineIndex& lineIndex);
+
+    /**
+     * @brief Constructs SymbolTable object
+     * @param concreteSyntaxTree - The compact CST of the program
+     */
+    SymbolTable(const CompactTree& concreteSyntaxTree);
+
+    /**
+     * @brief Empties the table, keeping its memory, and builds it again from
+     *        another CST
+     * @param concreteSyntaxTree - The concrete syntax tree that was 
+     *          generated in RecursiveDescentParser
+     */
+    void reset(const RecursiveDescentParser& concreteSyntaxTree);
+
+    /**
+     * @brief Adds the symbols declared by one statement of the CST
+     * @param statement - A complete statement from the parser's statement 
+     *                    table
+     */
+    void addStatement(const Statement<LCRSCursor>& statement);
+
+    /**
+     * @brief Returns true if a statement redefined a variable; statements 
+     *        added after that are ignored
+     */
+    bool hasError() const;
+
+    /**
+     * @brief Getter for diagnostic private variable
+     * @returns The error the symbol table stopped on
+     */
+    const Diagnostic& getDiagnostic() const;
 
     /**
      * @brief Output operator overload
@@ -60,10 +97,24 @@ public:
      */
     friend ostream& operator << (ostream& os, const SymbolTable& obj);
 private:
-    void parseParams(const vector<string>& params, int scope, const string& 
-                                                                paramListName);
-    list<TableEntry> table;
-    list<ParamListEntry> paramTable;
+    // the walks work on any tree that has a cursor (see TreeCursor.hpp)
+    template <typename Cursor>
+    void addStatements(const StatementTable<Cursor>& statements);
+    template <typename Cursor>
+    void addCursorStatement(const Statement<Cursor>& statement);
+    template <typename Cursor>
+    void addParams(Cursor node, int scope, SymbolId paramList);
+    void reportError(const Token& token, const string& message);
+    // vectors rather than lists, so that reset keeps their memory
+    vector<TableEntry> table;
+    vector<ParamListEntry> paramTable;
+    // the line index of the CST's program, for line numbers in errors
+    const LineIndex* lineIndex;
+    // set once a statement has an error, which is kept in diagnostic
+    bool failed;
+    Diagnostic diagnostic;
+    // a new scope starts after each top-level block
+    int scope;
     
     friend class AbstractSyntaxTree;
 };